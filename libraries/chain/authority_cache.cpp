@@ -0,0 +1,59 @@
+#include <hive/chain/authority_cache.hpp>
+#include <hive/chain/account_object.hpp>
+
+namespace hive { namespace chain {
+
+namespace {
+
+bool is_same_authority( const authority& cached, const shared_authority& current )
+{
+  return cached.weight_threshold == current.weight_threshold &&
+    std::equal( cached.account_auths.begin(), cached.account_auths.end(),
+      current.account_auths.begin(), current.account_auths.end() ) &&
+    std::equal( cached.key_auths.begin(), cached.key_auths.end(),
+      current.key_auths.begin(), current.key_auths.end() );
+}
+
+} // anonymous namespace
+
+template< typename GET_SHARED_AUTHORITY >
+const authority& authority_cache::get( const std::string& name, bool entry::*has_authority, authority entry::*cached_authority,
+  GET_SHARED_AUTHORITY get_shared_authority )
+{
+  // throws for unknown account just like getters that read account_authority_object directly
+  const shared_authority& current = get_shared_authority( _db.get< account_authority_object, by_account >( name ) );
+
+  entry& e = _entries[ account_name_type( name ) ];
+  if( !( e.*has_authority ) || !is_same_authority( e.*cached_authority, current ) )
+  {
+    e.*cached_authority = current;
+    e.*has_authority = true;
+  }
+  return e.*cached_authority;
+}
+
+const authority& authority_cache::get_active( const std::string& name )
+{
+  return get( name, &entry::has_active, &entry::active,
+    []( const account_authority_object& auth ) -> const shared_authority& { return auth.active; } );
+}
+
+const authority& authority_cache::get_owner( const std::string& name )
+{
+  return get( name, &entry::has_owner, &entry::owner,
+    []( const account_authority_object& auth ) -> const shared_authority& { return auth.owner; } );
+}
+
+const authority& authority_cache::get_posting( const std::string& name )
+{
+  return get( name, &entry::has_posting, &entry::posting,
+    []( const account_authority_object& auth ) -> const shared_authority& { return auth.posting; } );
+}
+
+void authority_cache::trim()
+{
+  if( _entries.size() > max_cached_accounts )
+    _entries.clear();
+}
+
+} } // hive::chain
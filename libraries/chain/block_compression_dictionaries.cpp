@@ -5,6 +5,10 @@
 
 #include <thread>
 #include <mutex>
+#include <fstream>
+#include <limits>
+#include <cstring>
+#include <map>
 #include <fc/log/logger.hpp>
 #include <fc/exception/exception.hpp>
 #include <hive/chain/block_compression_dictionaries.hpp>
@@ -12,8 +16,6 @@
 
 namespace hive { namespace chain {
 
-#ifdef HAS_COMPRESSION_DICTIONARIES
-
 // we store our dictionaries in compressed form, this is the maximum size
 // one will be when decompressed.  At the time of writing, we've decided
 // to use 220K dictionaries
@@ -37,12 +39,16 @@ std::map<uint8_t, ZSTD_DDict*> decompression_dictionaries;
 // maps a (dictionary_number, compression_level) pair to a ready-to-use compression dictionary
 std::map<std::pair<uint8_t, int>, ZSTD_CDict*> compression_dictionaries;
 
+// maps first block number of the range local dictionary was trained on to its dictionary_number
+std::map<uint32_t, uint8_t> local_dictionaries_by_first_block;
+
 // helper function, assumes the upper level function holds the mutex on our maps
 const decompressed_raw_dictionary_info& get_decompressed_raw_dictionary(uint8_t dictionary_number)
 {
   auto decompressed_dictionary_iter = decompressed_raw_dictionaries.find(dictionary_number);
   if (decompressed_dictionary_iter == decompressed_raw_dictionaries.end())
   {
+#ifdef HAS_COMPRESSION_DICTIONARIES
     // we don't.  do we have the raw, compressed dictionary?
     auto raw_iter = raw_dictionaries.find(dictionary_number);
     if (raw_iter == raw_dictionaries.end())
@@ -68,10 +74,14 @@ const decompressed_raw_dictionary_info& get_decompressed_raw_dictionary(uint8_t
                                                                                                                    decompressed_raw_dictionary_info{std::move(resized_buffer), uncompressed_dictionary_size}));
     if (!insert_succeeded)
       FC_THROW("Error storing decompressing dictionary ${dictionary_number}", (dictionary_number));
+#else
+    FC_THROW_EXCEPTION(fc::key_not_found_exception, "No dictionary ${dictionary_number} available -- hived was not built with compression dictionaries", (dictionary_number));
+#endif
   }
   return decompressed_dictionary_iter->second;
 }
 
+#ifdef HAS_COMPRESSION_DICTIONARIES
 std::optional<uint8_t> get_best_available_zstd_compression_dictionary_number_for_block(uint32_t block_number)
 {
   uint8_t last_available_dictionary = raw_dictionaries.rbegin()->first;
@@ -82,6 +92,17 @@ std::optional<uint8_t> get_last_available_zstd_compression_dictionary_number()
 {
   return raw_dictionaries.rbegin()->first;
 }
+#else // !defined(HAS_COMPRESSION_DICTIONARIES)
+std::optional<uint8_t> get_best_available_zstd_compression_dictionary_number_for_block(uint32_t block_number)
+{
+  return std::optional<uint8_t>();
+}
+
+std::optional<uint8_t> get_last_available_zstd_compression_dictionary_number()
+{
+  return std::optional<uint8_t>();
+}
+#endif // HAS_COMPRESSION_DICTIONARIES
 
 ZSTD_DDict* get_zstd_decompression_dictionary(uint8_t dictionary_number)
 {
@@ -116,26 +137,135 @@ ZSTD_CDict* get_zstd_compression_dictionary(uint8_t dictionary_number, int compr
   return dictionary;
 }
 
-#else // !defined(HAS_COMPRESSION_DICTIONARIES)
-std::optional<uint8_t> get_best_available_zstd_compression_dictionary_number_for_block(uint32_t block_number)
+fc::path get_local_zstd_compression_dictionary_file_name(uint8_t dictionary_number, uint32_t first_block_number)
 {
-  return std::optional<uint8_t>();
+  return fc::path("zstd_dictionary_" + std::to_string(dictionary_number) + "_" + std::to_string(first_block_number) + ".dict");
 }
 
-std::optional<uint8_t> get_last_available_zstd_compression_dictionary_number()
+// helper function, assumes the upper level function holds the mutex on our maps.
+// Returns false if the very same dictionary is already loaded, throws if the number is taken by a different one.
+bool add_local_zstd_compression_dictionary_locked(uint8_t dictionary_number, uint32_t first_block_number,
+                                                  std::unique_ptr<char[]>&& dictionary_data, size_t dictionary_size)
 {
-  return std::optional<uint8_t>();
+  FC_ASSERT(dictionary_number >= first_local_zstd_compression_dictionary_number,
+            "Dictionary ${dictionary_number} is not in the range of local dictionaries", (dictionary_number));
+  FC_ASSERT(dictionary_size > 0 && dictionary_size <= MAX_DICTIONARY_LENGTH, "Invalid size ${dictionary_size} of dictionary ${dictionary_number}",
+            (dictionary_size)(dictionary_number));
+
+  auto existing_iter = decompressed_raw_dictionaries.find(dictionary_number);
+  if (existing_iter != decompressed_raw_dictionaries.end())
+  {
+    // local dictionary numbers are process wide, so a block log from another directory can't bring its own
+    // dictionary under a number already in use - its blocks would be silently decompressed with the wrong one
+    auto first_block_iter = local_dictionaries_by_first_block.find(first_block_number);
+    const bool same_dictionary = existing_iter->second.size == dictionary_size &&
+                                 memcmp(existing_iter->second.buffer.get(), dictionary_data.get(), dictionary_size) == 0 &&
+                                 first_block_iter != local_dictionaries_by_first_block.end() && first_block_iter->second == dictionary_number;
+    FC_ASSERT(same_dictionary, "Dictionary ${dictionary_number} trained from block ${first_block_number} conflicts with an already loaded dictionary with the same number",
+              (dictionary_number)(first_block_number));
+    return false;
+  }
+
+  decompressed_raw_dictionaries.emplace(dictionary_number, decompressed_raw_dictionary_info{std::move(dictionary_data), dictionary_size});
+  local_dictionaries_by_first_block[first_block_number] = dictionary_number;
+  return true;
 }
 
-ZSTD_DDict* get_zstd_decompression_dictionary(uint8_t dictionary_number)
+void add_local_zstd_compression_dictionary(uint8_t dictionary_number, uint32_t first_block_number,
+                                           std::unique_ptr<char[]>&& dictionary_data, size_t dictionary_size)
 {
-  FC_THROW_EXCEPTION(fc::key_not_found_exception, "No dictionary ${dictionary_number} available -- hived was not built with compression dictionaries", (dictionary_number));
+  std::lock_guard<std::mutex> guard(dictionaries_mutex);
+  if (!add_local_zstd_compression_dictionary_locked(dictionary_number, first_block_number, std::move(dictionary_data), dictionary_size))
+    FC_THROW("Dictionary ${dictionary_number} is already loaded", (dictionary_number));
 }
 
-ZSTD_CDict* get_zstd_compression_dictionary(uint8_t dictionary_number, int compression_level)
+// helper function, returns false if given file name is not one produced by get_local_zstd_compression_dictionary_file_name
+bool parse_local_zstd_compression_dictionary_file_name(const fc::path& file, unsigned& dictionary_number, uint32_t& first_block_number)
 {
-  FC_THROW_EXCEPTION(fc::key_not_found_exception, "No dictionary ${dictionary_number} available -- hived was not built with compression dictionaries", (dictionary_number));
+  const std::string file_name = file.filename().string();
+  int characters_parsed = 0;
+  return sscanf(file_name.c_str(), "zstd_dictionary_%u_%u.dict%n", &dictionary_number, &first_block_number, &characters_parsed) == 2 &&
+         characters_parsed == (int)file_name.size() &&
+         dictionary_number >= first_local_zstd_compression_dictionary_number && dictionary_number <= std::numeric_limits<uint8_t>::max();
+}
+
+void load_local_zstd_compression_dictionaries(const fc::path& directory)
+{
+  if (directory.empty() || !fc::is_directory(directory))
+    return;
+
+  for (fc::directory_iterator it(directory); it != fc::directory_iterator(); ++it)
+  {
+    unsigned dictionary_number = 0;
+    uint32_t first_block_number = 0;
+    if (!parse_local_zstd_compression_dictionary_file_name(*it, dictionary_number, first_block_number))
+      continue;
+
+    // the file is always read, so a dictionary loaded before (f.e. by another block_log opened on the same
+    // directory concurrently) can be compared against it; check and insert happen under a single lock
+    const size_t dictionary_size = fc::file_size(*it);
+    std::unique_ptr<char[]> dictionary_data(new char[dictionary_size]);
+    std::ifstream dictionary_stream(it->generic_string(), std::ios::in | std::ios::binary);
+    dictionary_stream.read(dictionary_data.get(), dictionary_size);
+    FC_ASSERT(dictionary_stream.good(), "Error reading dictionary file ${file}", ("file", *it));
+
+    bool loaded = false;
+    {
+      std::lock_guard<std::mutex> guard(dictionaries_mutex);
+      loaded = add_local_zstd_compression_dictionary_locked((uint8_t)dictionary_number, first_block_number, std::move(dictionary_data), dictionary_size);
+    }
+    if (loaded)
+      ilog("Loaded local compression dictionary ${dictionary_number} trained from block ${first_block_number}", (dictionary_number)(first_block_number));
+  }
+}
+
+void copy_local_zstd_compression_dictionaries(const fc::path& source_directory, const fc::path& destination_directory)
+{
+  if (source_directory.empty() || !fc::is_directory(source_directory) ||
+      fc::canonical(source_directory) == fc::canonical(destination_directory))
+    return;
+
+  for (fc::directory_iterator it(source_directory); it != fc::directory_iterator(); ++it)
+  {
+    unsigned dictionary_number = 0;
+    uint32_t first_block_number = 0;
+    if (!parse_local_zstd_compression_dictionary_file_name(*it, dictionary_number, first_block_number))
+      continue;
+
+    // a different file already present under the same name is caught when the destination block log loads it
+    const fc::path destination_file = destination_directory / it->filename();
+    if (fc::exists(destination_file))
+      continue;
+    fc::copy(*it, destination_file);
+    ilog("Copied local compression dictionary ${dictionary_number} to ${destination_directory}", (dictionary_number)(destination_directory));
+  }
+}
+
+bool is_known_zstd_compression_dictionary_number(uint8_t dictionary_number)
+{
+  if (dictionary_number < first_local_zstd_compression_dictionary_number)
+    return dictionary_number <= get_last_available_zstd_compression_dictionary_number().value_or(0);
+
+  std::lock_guard<std::mutex> guard(dictionaries_mutex);
+  return decompressed_raw_dictionaries.find(dictionary_number) != decompressed_raw_dictionaries.end();
+}
+
+std::optional<uint8_t> get_local_zstd_compression_dictionary_number_for_block(uint32_t block_number)
+{
+  std::lock_guard<std::mutex> guard(dictionaries_mutex);
+  auto iter = local_dictionaries_by_first_block.upper_bound(block_number);
+  if (iter == local_dictionaries_by_first_block.begin())
+    return std::optional<uint8_t>();
+  return std::prev(iter)->second;
+}
+
+std::optional<uint8_t> get_next_free_local_zstd_compression_dictionary_number()
+{
+  std::lock_guard<std::mutex> guard(dictionaries_mutex);
+  for (unsigned dictionary_number = first_local_zstd_compression_dictionary_number; dictionary_number <= std::numeric_limits<uint8_t>::max(); ++dictionary_number)
+    if (decompressed_raw_dictionaries.find((uint8_t)dictionary_number) == decompressed_raw_dictionaries.end())
+      return (uint8_t)dictionary_number;
+  return std::optional<uint8_t>();
 }
-#endif // HAS_COMPRESSION_DICTIONARIES
  
 } } // end namespace hive::chain
@@ -8,6 +8,9 @@
 #include <hive/chain/blockchain_worker_thread_pool.hpp>
 
 #include <queue>
+#include <list>
+#include <unordered_map>
+#include <mutex>
 #include <fstream>
 #include <fc/io/raw.hpp>
 #include <fc/thread/thread.hpp>
@@ -92,6 +95,57 @@ namespace hive { namespace chain {
   boost::interprocess::defer_lock_type defer_lock;
 
   namespace detail {
+    // keeps the most recently read blocks, so peers syncing the same range and API calls asking for
+    // recent blocks share one full_block_type (together with its decompressed and decoded forms)
+    // instead of reading and decoding the block again for each request
+    class recent_blocks_cache
+    {
+      public:
+        explicit recent_blocks_cache(size_t capacity) : _capacity(capacity) {}
+
+        std::shared_ptr<full_block_type> get(uint32_t block_num)
+        {
+          std::lock_guard<std::mutex> guard(_mutex);
+          auto iter = _blocks_by_num.find(block_num);
+          if (iter == _blocks_by_num.end())
+            return std::shared_ptr<full_block_type>();
+          _blocks.splice(_blocks.begin(), _blocks, iter->second);
+          return iter->second->second;
+        }
+
+        void put(uint32_t block_num, const std::shared_ptr<full_block_type>& full_block)
+        {
+          std::lock_guard<std::mutex> guard(_mutex);
+          auto iter = _blocks_by_num.find(block_num);
+          if (iter != _blocks_by_num.end())
+          {
+            _blocks.splice(_blocks.begin(), _blocks, iter->second);
+            return;
+          }
+          _blocks.emplace_front(block_num, full_block);
+          _blocks_by_num[block_num] = _blocks.begin();
+          if (_blocks.size() > _capacity)
+          {
+            _blocks_by_num.erase(_blocks.back().first);
+            _blocks.pop_back();
+          }
+        }
+
+        void clear()
+        {
+          std::lock_guard<std::mutex> guard(_mutex);
+          _blocks_by_num.clear();
+          _blocks.clear();
+        }
+
+      private:
+        typedef std::list<std::pair<uint32_t, std::shared_ptr<full_block_type>>> block_list_t;
+        std::mutex _mutex;
+        const size_t _capacity;
+        block_list_t _blocks; // most recently used first
+        std::unordered_map<uint32_t, block_list_t::iterator> _blocks_by_num;
+    };
+
     class block_log_impl {
       public:
         std::shared_ptr<full_block_type> head;
@@ -112,6 +166,11 @@ namespace hive { namespace chain {
         bool compression_enabled = true;
         bool auto_fixing_enabled = true;
 
+        // 512 blocks is enough to cover requests of a few peers syncing at the same time; only used when
+        // enabled by the opener (the node, for its p2p and API readers), sequential readers would only churn it
+        bool recent_blocks_cache_enabled = false;
+        recent_blocks_cache recent_blocks{512};
+
         // during testing (around block 63M) we found level 15 to be a good balance between ratio 
         // and compression/decompression times of ~3.5ms & 65μs, so we're making level 15 the default, and the 
         // dictionaries are optimized for level 15
@@ -208,6 +267,9 @@ namespace hive { namespace chain {
         const fc::path parent_path = my->block_file.parent_path();
         if (!fc::exists(parent_path) && !parent_path.empty())
           boost::filesystem::create_directories( my->block_file.parent_path().generic_string() );
+
+        // dictionaries trained locally (see compress_block_log) are kept next to the block log they were used for
+        load_local_zstd_compression_dictionaries(parent_path);
       }
 
       std::string file_str = my->block_file.generic_string();
@@ -302,6 +364,7 @@ namespace hive { namespace chain {
       my->block_log_fd = -1;
     }
     std::atomic_store(&my->head, std::shared_ptr<full_block_type>());
+    my->recent_blocks.clear();
   }
 
   bool block_log::is_open()const
@@ -487,6 +550,11 @@ namespace hive { namespace chain {
   }
 
   std::shared_ptr<full_block_type> block_log::read_block_by_num( uint32_t block_num )const
+  {
+    return read_block_by_num(block_num, my->recent_blocks_cache_enabled);
+  }
+
+  std::shared_ptr<full_block_type> block_log::read_block_by_num(uint32_t block_num, bool use_cache) const
   {
     try
     {
@@ -500,18 +568,32 @@ namespace hive { namespace chain {
       if (block_num == head_block->get_block_num())
         return head_block;
 
-      // if we're still here, we know that it's in the block log, and the block after it is also
-      // in the block log (which means we can determine its size)
-      std::tuple<std::unique_ptr<char[]>, size_t, block_log_artifacts::artifacts_t> raw_block_data = read_raw_block_data_by_num(block_num);
-      block_log_artifacts::artifacts_t artifacts = std::get<2>(std::move(raw_block_data));
+      if (!use_cache)
+        return read_block_by_num_from_disk(block_num);
 
-      return artifacts.attributes.flags == block_flags::uncompressed ? 
-        full_block_type::create_from_uncompressed_block_data(std::get<0>(std::move(raw_block_data)), std::get<1>(raw_block_data), artifacts.block_id) :
-        full_block_type::create_from_compressed_block_data(std::get<0>(std::move(raw_block_data)), std::get<1>(raw_block_data), artifacts.attributes, artifacts.block_id);
+      std::shared_ptr<full_block_type> full_block = my->recent_blocks.get(block_num);
+      if (full_block)
+        return full_block;
+
+      full_block = read_block_by_num_from_disk(block_num);
+      my->recent_blocks.put(block_num, full_block);
+      return full_block;
     }
     FC_CAPTURE_LOG_AND_RETHROW((block_num))
   }
 
+  std::shared_ptr<full_block_type> block_log::read_block_by_num_from_disk(uint32_t block_num) const
+  {
+    // the caller made sure the block is in the block log and the block after it is also
+    // in the block log (which means we can determine its size)
+    std::tuple<std::unique_ptr<char[]>, size_t, block_log_artifacts::artifacts_t> raw_block_data = read_raw_block_data_by_num(block_num);
+    block_log_artifacts::artifacts_t artifacts = std::get<2>(std::move(raw_block_data));
+
+    return artifacts.attributes.flags == block_flags::uncompressed ? 
+      full_block_type::create_from_uncompressed_block_data(std::get<0>(std::move(raw_block_data)), std::get<1>(raw_block_data), artifacts.block_id) :
+      full_block_type::create_from_compressed_block_data(std::get<0>(std::move(raw_block_data)), std::get<1>(raw_block_data), artifacts.attributes, artifacts.block_id);
+  }
+
   std::shared_ptr<full_block_type> block_log::read_block_by_offset(uint64_t offset, size_t size, block_attributes_t attributes) const
   {
     std::unique_ptr<char[]> serialized_data(new char[size]);
@@ -567,11 +649,33 @@ namespace hive { namespace chain {
       {
         result.reserve(count);
 
+        // take what we can from the cache of recently read blocks, only the span between the first
+        // and the last block missing there has to be read from the disk
+        std::vector<std::shared_ptr<full_block_type>> cached_blocks;
+        cached_blocks.reserve(last_block_num_from_disk - first_block_num + 1);
+        for (uint32_t block_num = first_block_num; block_num <= last_block_num_from_disk; ++block_num)
+          cached_blocks.push_back(my->recent_blocks_cache_enabled ? my->recent_blocks.get(block_num) : std::shared_ptr<full_block_type>());
+
+        auto is_missing = [](const std::shared_ptr<full_block_type>& full_block) { return !full_block; };
+        auto first_missing = std::find_if(cached_blocks.begin(), cached_blocks.end(), is_missing);
+        if (first_missing == cached_blocks.end())
+        {
+          result = std::move(cached_blocks);
+          if (last_block_is_head_block)
+            result.push_back(head_block);
+          return result;
+        }
+        auto last_missing = std::find_if(cached_blocks.rbegin(), cached_blocks.rend(), is_missing);
+        uint32_t first_missing_block_num = first_block_num + (uint32_t)(first_missing - cached_blocks.begin());
+        uint32_t last_missing_block_num = first_block_num + (uint32_t)(cached_blocks.rend() - last_missing) - 1;
+
+        result.insert(result.end(), cached_blocks.begin(), first_missing);
+
         // then we need to read blocks from the disk
-        uint32_t number_of_blocks_to_read = last_block_num_from_disk - first_block_num + 1;
+        uint32_t number_of_blocks_to_read = last_missing_block_num - first_missing_block_num + 1;
 
         size_t size_of_all_blocks = 0;
-        auto plural_of_block_artifacts = my->_artifacts->read_block_artifacts(first_block_num, number_of_blocks_to_read, &size_of_all_blocks);
+        auto plural_of_block_artifacts = my->_artifacts->read_block_artifacts(first_missing_block_num, number_of_blocks_to_read, &size_of_all_blocks);
 
         uint64_t first_block_offset = plural_of_block_artifacts.front().block_log_file_pos;
 
@@ -581,8 +685,16 @@ namespace hive { namespace chain {
         detail::block_log_impl::pread_with_retry(my->block_log_fd, block_data.get(), size_of_all_blocks, first_block_offset);
 
         // now deserialize the blocks
+        uint32_t block_num = first_missing_block_num;
         for (const block_log_artifacts::artifacts_t& block_artifacts : plural_of_block_artifacts)
         {
+          const std::shared_ptr<full_block_type>& cached_block = cached_blocks[block_num++ - first_block_num];
+          if (cached_block)
+          {
+            result.push_back(cached_block);
+            continue;
+          }
+
           // full_block_type expects to take ownership of a unique_ptr for the memory, so create one
           std::unique_ptr<char[]> compressed_block_data(new char[block_artifacts.block_serialized_data_size]);
           memcpy(compressed_block_data.get(), block_data.get() + block_artifacts.block_log_file_pos - first_block_offset, 
@@ -595,7 +707,11 @@ namespace hive { namespace chain {
             result.push_back(full_block_type::create_from_compressed_block_data(std::move(compressed_block_data), 
                                                                                 block_artifacts.block_serialized_data_size, 
                                                                                 block_artifacts.attributes, block_artifacts.block_id));
+          if (my->recent_blocks_cache_enabled)
+            my->recent_blocks.put(block_num - 1, result.back());
         }
+
+        result.insert(result.end(), last_missing.base(), cached_blocks.end());
       }
 
       if (last_block_is_head_block)
@@ -656,9 +772,11 @@ namespace hive { namespace chain {
   }
 
   void block_log::open_and_init( const fc::path& file, bool read_only, bool enable_compression,
-    int compression_level, bool enable_block_log_auto_fixing, hive::chain::blockchain_worker_thread_pool& thread_pool )
+    int compression_level, bool enable_block_log_auto_fixing, hive::chain::blockchain_worker_thread_pool& thread_pool,
+    bool cache_recent_blocks /* = false */ )
   {
     my->auto_fixing_enabled = enable_block_log_auto_fixing;
+    my->recent_blocks_cache_enabled = cache_recent_blocks;
     open( file, thread_pool, read_only, true /*write_fallback*/ );
     my->compression_enabled = enable_compression;
     my->zstd_level = compression_level;
@@ -819,6 +937,19 @@ namespace hive { namespace chain {
     std::mutex block_queue_mutex;
     std::condition_variable block_queue_condition;
 
+    // pipeline statistics: reader stage -> (workers decoding) -> processor stage; stalls tell which stage is the bottleneck
+    struct
+    {
+      uint32_t blocks_processed = 0;
+      uint32_t reader_stalls = 0; // reader found queue full (processor is the bottleneck)
+      fc::microseconds reader_stall_time;
+      uint32_t processor_stalls = 0; // processor found queue empty (I/O is the bottleneck)
+      fc::microseconds processor_stall_time;
+      uint32_t not_decoded_blocks = 0; // processor got block before workers decoded it (workers are the bottleneck)
+      uint64_t accumulated_queue_depth = 0;
+    } stats;
+    const fc::time_point pipeline_start_time = fc::time_point::now();
+
     hive::chain::blockchain_worker_thread_pool::data_source_type worker_thread_processing;
     switch (purpose)
     {
@@ -837,11 +968,18 @@ namespace hive { namespace chain {
       fc::thread::current().set_name("for_each_io"); // tells fc the thread's name for logging
       for (uint32_t block_number = starting_block_number; block_number <= ending_block_number; ++block_number)
       {
-        std::shared_ptr<full_block_type> full_block = read_block_by_num(block_number);
+        // every block is read once here, so going through the cache would only evict the blocks peers ask for
+        std::shared_ptr<full_block_type> full_block = read_block_by_num(block_number, false /*use_cache*/);
         {
           std::unique_lock<std::mutex> lock(block_queue_mutex);
-          while (block_queue.size() >= max_blocks_to_prefetch && !stop_requested)
-            block_queue_condition.wait(lock);
+          if (block_queue.size() >= max_blocks_to_prefetch && !stop_requested)
+          {
+            const fc::time_point stall_start = fc::time_point::now();
+            while (block_queue.size() >= max_blocks_to_prefetch && !stop_requested)
+              block_queue_condition.wait(lock);
+            ++stats.reader_stalls;
+            stats.reader_stall_time += fc::time_point::now() - stall_start;
+          }
           if (stop_requested)
           {
             ilog("Leaving the queue thread");
@@ -861,11 +999,18 @@ namespace hive { namespace chain {
       std::shared_ptr<full_block_type> full_block;
       {
         std::unique_lock<std::mutex> lock(block_queue_mutex);
-        while (block_queue.empty() && !stop_requested)
-          block_queue_condition.wait(lock);
+        if (block_queue.empty() && !stop_requested)
+        {
+          const fc::time_point stall_start = fc::time_point::now();
+          while (block_queue.empty() && !stop_requested)
+            block_queue_condition.wait(lock);
+          ++stats.processor_stalls;
+          stats.processor_stall_time += fc::time_point::now() - stall_start;
+        }
 
         if(!stop_requested)
         { 
+          stats.accumulated_queue_depth += block_queue.size();
           full_block = block_queue.front();
           block_queue.pop();
         }
@@ -876,7 +1021,12 @@ namespace hive { namespace chain {
       try
       {
         if(!stop_requested)
+        {
+          ++stats.blocks_processed;
+          if (purpose == for_each_purpose::replay && !full_block->has_decoded_block())
+            ++stats.not_decoded_blocks;
           stop_requested = !processor(full_block);
+        }
 
         if (stop_requested)
         {
@@ -906,6 +1056,16 @@ namespace hive { namespace chain {
     ilog("Attempting to join queue_filler_thread...");
     queue_filler_thread.join();
     ilog("queue_filler_thread joined.");
+
+    const fc::microseconds pipeline_time = fc::time_point::now() - pipeline_start_time;
+    ilog("Block processing pipeline finished ${blocks_processed} blocks in ${pipeline_time} ms, average queue depth: ${avg_depth} (limit ${max_blocks_to_prefetch})",
+         ("blocks_processed", stats.blocks_processed)("pipeline_time", pipeline_time.count() / 1000)
+         ("avg_depth", stats.blocks_processed ? stats.accumulated_queue_depth / stats.blocks_processed : 0)(max_blocks_to_prefetch));
+    ilog("Reader stalled on full queue ${reader_stalls} times (${reader_stall_time} ms), processor waited for reader ${processor_stalls} times (${processor_stall_time} ms), "
+         "${not_decoded_blocks} blocks reached processor before being decoded by worker threads",
+         ("reader_stalls", stats.reader_stalls)("reader_stall_time", stats.reader_stall_time.count() / 1000)
+         ("processor_stalls", stats.processor_stalls)("processor_stall_time", stats.processor_stall_time.count() / 1000)
+         ("not_decoded_blocks", stats.not_decoded_blocks));
   }
 
   void block_log::truncate(uint32_t new_head_block_num)
@@ -928,6 +1088,7 @@ namespace hive { namespace chain {
     FC_ASSERT(ftruncate(my->block_log_fd, final_block_log_size) == 0, 
               "failed to truncate block log, ${error}", ("error", strerror(errno)));
     my->_artifacts->truncate(new_head_block_num);
+    my->recent_blocks.clear();
     std::atomic_store(&my->head, read_head());
   }
 
@@ -970,9 +1131,9 @@ namespace hive { namespace chain {
             const bool flags_are_plausible = (block_offset_with_flags & 0x7e00000000000000ull) == 0;
 
             bool dictionary_is_plausible;
-            // if the dictionary flag bit is set, verify that the dictionary number is one that we have.
+            // if the dictionary flag bit is set, verify that the dictionary number is one that we have (built-in or local).
             if (block_offset_with_flags & 0x0100000000000000ull)
-              dictionary_is_plausible = *flags.dictionary_number <= hive::chain::get_last_available_zstd_compression_dictionary_number().value_or(0);
+              dictionary_is_plausible = hive::chain::is_known_zstd_compression_dictionary_number(*flags.dictionary_number);
             // if the dictionary flag bit is not set, expect the dictionary number to be zeroed
             else
               dictionary_is_plausible = (block_offset_with_flags & 0x00ff000000000000ull) == 0;
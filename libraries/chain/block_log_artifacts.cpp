@@ -256,7 +256,8 @@ private:
   bool load_header();
 
   void generate_artifacts_file(const block_log& source_block_provider, hive::chain::blockchain_worker_thread_pool& thread_pool);
-  void verify_if_blocks_from_block_log_matches_artifacts(const block_log& source_block_provider, const bool full_match_verification, const bool use_block_log_head_num) const;
+  void verify_if_blocks_from_block_log_matches_artifacts(const block_log& source_block_provider, const bool full_match_verification, const bool use_block_log_head_num,
+    hive::chain::blockchain_worker_thread_pool& thread_pool) const;
   
   template <class Data>
   void write_data(const Data& buffer, off_t offset, const std::string& description) const
@@ -414,7 +415,7 @@ void block_log_artifacts::impl::open(const fc::path& block_log_file_path,
       FC_THROW("Artifacts file generating process is not finished.\nDetails:\n ${details}", ("details", get_artifacts_contents(_header.generating_interrupted_at_block, _header.generating_interrupted_at_block, false)));
     }
     
-    verify_if_blocks_from_block_log_matches_artifacts(source_block_provider, full_match_verification, false);
+    verify_if_blocks_from_block_log_matches_artifacts(source_block_provider, full_match_verification, false, thread_pool);
   }
 
   else
@@ -475,7 +476,7 @@ void block_log_artifacts::impl::open(const fc::path& block_log_file_path,
           if (_header.generating_interrupted_at_block > block_log_head_block_num)
             FC_THROW("Artifacts file has been filled up to ${interrupted_at_block} block, truncating artifacts file will result an empty file. Remove artifacts file and create artifacts from the beggining.", ("interrupted_at_block", _header.generating_interrupted_at_block));
 
-          verify_if_blocks_from_block_log_matches_artifacts(source_block_provider, full_match_verification, true);
+          verify_if_blocks_from_block_log_matches_artifacts(source_block_provider, full_match_verification, true, thread_pool);
           truncate_file(block_log_head_block_num);
 
           if (_header.generating_interrupted_at_block)
@@ -483,7 +484,7 @@ void block_log_artifacts::impl::open(const fc::path& block_log_file_path,
         }
         else
         {
-          verify_if_blocks_from_block_log_matches_artifacts(source_block_provider, full_match_verification, false);
+          verify_if_blocks_from_block_log_matches_artifacts(source_block_provider, full_match_verification, false, thread_pool);
 
           if (_header.generating_interrupted_at_block)
             generate_artifacts_file(source_block_provider, thread_pool);
@@ -679,7 +680,8 @@ void block_log_artifacts::impl::generate_artifacts_file(const block_log& source_
     (elapsed_time)(processed_blocks_count)("was_interrupted", (static_cast<bool>(_header.generating_interrupted_at_block))));
 }
 
-void block_log_artifacts::impl::verify_if_blocks_from_block_log_matches_artifacts(const block_log& source_block_provider, const bool full_match_verification, const bool use_block_log_head_num) const
+void block_log_artifacts::impl::verify_if_blocks_from_block_log_matches_artifacts(const block_log& source_block_provider, const bool full_match_verification, const bool use_block_log_head_num,
+  hive::chain::blockchain_worker_thread_pool& thread_pool) const
 {
   constexpr uint32_t BLOCKS_SAMPLE_AMOUNT = 10;
 
@@ -711,10 +713,36 @@ void block_log_artifacts::impl::verify_if_blocks_from_block_log_matches_artifact
   {
     uint32_t counter = 0;
 
-    while(block_num > last_block_num_to_verify)
+    // blocks are read (and handed to the worker pool for decompression and header decoding) up to
+    // MAX_BLOCKS_TO_PREFETCH ahead of the block being compared, so on full verification of a large
+    // block_log the comparison loop mostly finds the block id already computed
+    struct block_to_verify
     {
-      const auto block_artifacts = read_block_artifacts(block_num);
-      const auto full_block = source_block_provider.read_block_by_offset(block_artifacts.block_log_file_pos, block_artifacts.block_serialized_data_size, block_artifacts.attributes);
+      uint32_t block_num;
+      block_log_artifacts::artifacts_t block_artifacts;
+      std::shared_ptr<full_block_type> full_block;
+    };
+    constexpr size_t MAX_BLOCKS_TO_PREFETCH = 1000;
+    std::queue<block_to_verify> prefetched_blocks;
+    uint32_t next_block_num_to_read = first_block_to_verify;
+
+    while(next_block_num_to_read > last_block_num_to_verify || !prefetched_blocks.empty())
+    {
+      while (next_block_num_to_read > last_block_num_to_verify && prefetched_blocks.size() < MAX_BLOCKS_TO_PREFETCH)
+      {
+        block_num = next_block_num_to_read;
+        auto block_artifacts = read_block_artifacts(next_block_num_to_read);
+        auto full_block = source_block_provider.read_block_by_offset(block_artifacts.block_log_file_pos, block_artifacts.block_serialized_data_size, block_artifacts.attributes);
+        thread_pool.enqueue_work(full_block, blockchain_worker_thread_pool::data_source_type::block_log_for_artifact_generation);
+        prefetched_blocks.push(block_to_verify{next_block_num_to_read, std::move(block_artifacts), std::move(full_block)});
+        --next_block_num_to_read;
+      }
+
+      const block_to_verify current = std::move(prefetched_blocks.front());
+      prefetched_blocks.pop();
+      block_num = current.block_num;
+      const auto& block_artifacts = current.block_artifacts;
+      const auto& full_block = current.full_block;
       if (full_block->get_block_id() != block_artifacts.block_id)
         FC_THROW("Full block got by offset has malformed ID");
       if (full_block->has_compressed_block_data())
@@ -730,7 +758,6 @@ void block_log_artifacts::impl::verify_if_blocks_from_block_log_matches_artifact
       else if (full_block->get_uncompressed_block_size() != block_artifacts.block_serialized_data_size)
         FC_THROW("Full block got by offset has malformed uncompressed block size!");
 
-      --block_num;
       ++counter;
 
       if (counter >= 1000000)
@@ -30,6 +30,7 @@ struct blockchain_worker_thread_pool::impl
     {
       std::weak_ptr<full_transaction_type> full_transaction;
       std::optional<uint32_t> block_number; // if this transaction was received in a block, it's number
+      uint32_t computations = blockchain_worker_thread_pool::all_transaction_computations; // what to precompute for transaction inside a block
     };
     std::variant<std::weak_ptr<full_block_type>, transaction_work_request_type> block_or_transaction;
     blockchain_worker_thread_pool::data_source_type data_source;
@@ -54,7 +55,7 @@ struct blockchain_worker_thread_pool::impl
 
   appbase::application& theApp;
 
-  using enqueue_work_type = std::function<void(const std::vector<std::shared_ptr<full_transaction_type>>&, data_source_type, std::optional<uint32_t>)>;
+  using enqueue_work_type = std::function<void(const std::vector<std::shared_ptr<full_transaction_type>>&, data_source_type, std::optional<uint32_t>, uint32_t)>;
   enqueue_work_type enqueue_work;
 
   impl( appbase::application& app, enqueue_work_type&& enqueue_work );
@@ -62,6 +63,9 @@ struct blockchain_worker_thread_pool::impl
   bool allow_enqueue_work() const;
   bool is_running() const;
 
+  uint32_t get_transaction_computations_for_p2p_block(uint32_t block_number) const;
+  void precompute_transaction(const full_transaction_type& full_transaction, uint32_t computations) const;
+
   bool dequeue_work(work_request_type*& work_request_ptr);
 
   void perform_work(const std::weak_ptr<full_block_type>& full_block, data_source_type data_source);
@@ -85,6 +89,59 @@ bool blockchain_worker_thread_pool::impl::is_running() const
   return running.load(std::memory_order_relaxed) && !theApp.is_interrupt_request();
 }
 
+uint32_t blockchain_worker_thread_pool::impl::get_transaction_computations_for_p2p_block(uint32_t block_number) const
+{
+  // nothing is validated before the last checkpoint
+  if (last_checkpoint && block_number <= *last_checkpoint)
+    return 0;
+
+  // validate is always called during normal block processing, but by default signature validation isn't
+  // done unless you specify --p2p-force-validate or you're a witness (see skip flags set by p2p_plugin)
+  if (p2p_force_validate || is_block_producer)
+    return all_transaction_computations;
+  return validation;
+}
+
+void blockchain_worker_thread_pool::impl::precompute_transaction(const full_transaction_type& full_transaction, uint32_t computations) const
+{
+  // we ignore exceptions for all calls, we're just trying to make the full_transaction precompute the
+  // result (or, if there's an error, precompute the exception).  Just like with a normal result, the
+  // full_transaction will cache any exceptions thrown now and rethrow them when and if the blockchain
+  // makes the corresponding call during the course of apply_transaction.
+  if (computations & validation)
+  {
+    try
+    {
+      full_transaction.precompute_validation();
+    }
+    catch (...)
+    {
+    }
+  }
+
+  if (computations & signature_keys)
+  {
+    try
+    {
+      full_transaction.compute_signature_keys();
+    }
+    catch (...)
+    {
+    }
+  }
+
+  if (computations & required_authorities)
+  {
+    try
+    {
+      full_transaction.compute_required_authorities();
+    }
+    catch (...)
+    {
+    }
+  }
+}
+
 bool blockchain_worker_thread_pool::impl::dequeue_work(work_request_type*& work_request_ptr)
 {
   return std::find_if(work_queues.begin(), work_queues.end(), 
@@ -161,7 +218,7 @@ void blockchain_worker_thread_pool::impl_deleter::operator()(blockchain_worker_t
 //std::shared_ptr<std::thread> fill_queue_thread = std::make_shared<std::thread>([&](){ fill_pending_queue(input_block_log_path / "block_log"); });
 blockchain_worker_thread_pool::blockchain_worker_thread_pool( appbase::application& app ) :
   my(std::unique_ptr<impl, impl_deleter>( new impl( app, [this]( const std::vector<std::shared_ptr<full_transaction_type>>& full_transactions, data_source_type data_source,
-                                                 std::optional<uint32_t> block_number ){ this->enqueue_work( full_transactions, data_source, block_number ); } ) ) )
+                                                 std::optional<uint32_t> block_number, uint32_t computations ){ this->enqueue_work( full_transactions, data_source, block_number, computations ); } ) ) )
 {
 }
 
@@ -184,11 +241,15 @@ void blockchain_worker_thread_pool::impl::perform_work(const std::weak_ptr<full_
         // fully decompress (if necessary) the block and unpack it
         full_block->decode_block();
 
-        // now we have the full_transactions, get started working on them
-        FC_ASSERT( enqueue_work );
-        enqueue_work(full_block->get_full_transactions(),
-                      blockchain_worker_thread_pool::data_source_type::transaction_inside_block_received_from_p2p,
-                      full_block->get_block_num());
+        // now we have the full_transactions, get started working on them (unless database::_apply_block()
+        // got to the block first and already queued what its skip flags need)
+        if (uint32_t computations = full_block->mark_transaction_computations_queued(get_transaction_computations_for_p2p_block(full_block->get_block_num())))
+        {
+          FC_ASSERT( enqueue_work );
+          enqueue_work(full_block->get_full_transactions(),
+                        blockchain_worker_thread_pool::data_source_type::transaction_inside_block_received_from_p2p,
+                        full_block->get_block_num(), computations);
+        }
         // precompute some stuff we'll need for validating the block
         full_block->compute_signing_key();
         full_block->compute_merkle_root();
@@ -237,9 +298,10 @@ void blockchain_worker_thread_pool::impl::perform_work(const std::weak_ptr<full_
         {
           // now we have the full_transactions, get started working on them
           FC_ASSERT( enqueue_work && "Not set" );
+          full_block->mark_transaction_computations_queued(all_transaction_computations);
           enqueue_work(full_block->get_full_transactions(),
             blockchain_worker_thread_pool::data_source_type::transaction_inside_block_for_replay,
-            full_block->get_block_num());
+            full_block->get_block_num(), all_transaction_computations);
           full_block->compute_signing_key();
           full_block->compute_merkle_root();
         }
@@ -281,42 +343,9 @@ void blockchain_worker_thread_pool::impl::perform_work(const work_request_type::
   switch (data_source)
   {
     case blockchain_worker_thread_pool::data_source_type::transaction_inside_block_received_from_p2p:
-      // this depends a bit on what the current validation settings are
-      try
-      {
-        // validate is always called during normal block processing, unless there's a checkpoint in the future
-        if (!last_checkpoint || transaction_work_request.block_number > *last_checkpoint)
-          full_transaction->precompute_validation();
-      }
-      catch (...)
-      {
-        // we ignore exceptions for all calls, we're just trying to make the full_transaction precompute the
-        // result (or, if there's an error, precompute the exception).  Just like with a normal result, the
-        // full_transaction will cache any exceptions thrown now and rethrow them when and if the blockchain
-        // makes the corresponding call during the course of apply_transaction.
-      }
-
-      // but by default, signature validation isn't done unless you specify --p2p-force-validate
-      // or you're a witness
-      if ((p2p_force_validate || is_block_producer) && // if we're doing full validation
-          (!last_checkpoint || transaction_work_request.block_number > *last_checkpoint)) // and we've passed the last checkpoint
-      {
-        try
-        {
-          full_transaction->compute_signature_keys();
-        }
-        catch (...)
-        {
-        }
-
-        try
-        {
-          full_transaction->compute_required_authorities();
-        }
-        catch (...)
-        {
-        }
-      }
+      // the block's perform_work already picked what the current validation settings need
+      // (see get_transaction_computations_for_p2p_block())
+      precompute_transaction(*full_transaction, transaction_work_request.computations);
       break;
     case blockchain_worker_thread_pool::data_source_type::transaction_inside_block_for_replay:
       // by default very little checking is done during replay, unless you specify --validate_during_replay
@@ -355,6 +384,13 @@ void blockchain_worker_thread_pool::impl::perform_work(const work_request_type::
         }
       }
       break;
+    case blockchain_worker_thread_pool::data_source_type::transaction_inside_block_for_apply:
+      // the block is already being applied on the write thread, which walks its transactions in order;
+      // we run ahead of it and compute what its skip flags require, so by the time _apply_transaction()
+      // reaches a transaction it only finds cached results (or cached exceptions) and the final state is
+      // exactly what serial execution would produce
+      precompute_transaction(*full_transaction, transaction_work_request.computations);
+      break;
     case blockchain_worker_thread_pool::data_source_type::standalone_transaction_received_from_p2p:
     case blockchain_worker_thread_pool::data_source_type::standalone_transaction_received_from_api:
       // check this, but I think all standalone transactions will need full validation
@@ -418,6 +454,7 @@ namespace
     {
       case blockchain_worker_thread_pool::data_source_type::transaction_inside_block_received_from_p2p:
       case blockchain_worker_thread_pool::data_source_type::transaction_inside_block_for_replay:
+      case blockchain_worker_thread_pool::data_source_type::transaction_inside_block_for_apply:
         return blockchain_worker_thread_pool::impl::priority_type::high;
       case blockchain_worker_thread_pool::data_source_type::standalone_transaction_received_from_p2p:
       case blockchain_worker_thread_pool::data_source_type::standalone_transaction_received_from_api:
@@ -461,7 +498,7 @@ void blockchain_worker_thread_pool::enqueue_work(const std::shared_ptr<full_tran
 }
 
 void blockchain_worker_thread_pool::enqueue_work(const std::vector<std::shared_ptr<full_transaction_type>>& full_transactions, data_source_type data_source,
-                                                 std::optional<uint32_t> block_number)
+                                                 std::optional<uint32_t> block_number, uint32_t computations)
 {
   if (!my->allow_enqueue_work())
     return;
@@ -471,7 +508,7 @@ void blockchain_worker_thread_pool::enqueue_work(const std::vector<std::shared_p
   std::transform(full_transactions.begin(), full_transactions.end(),
                  std::back_inserter(work_requests),
                  [&](const std::shared_ptr<full_transaction_type>& full_transaction) { 
-    return std::unique_ptr<impl::work_request_type>(new impl::work_request_type{impl::work_request_type::transaction_work_request_type{full_transaction, std::optional<uint32_t>()}, data_source});
+    return std::unique_ptr<impl::work_request_type>(new impl::work_request_type{impl::work_request_type::transaction_work_request_type{full_transaction, block_number, computations}, data_source});
   });
   impl::priority_type priority = get_priority_for_transaction(data_source);
 
@@ -7,6 +7,7 @@
 #include <hive/protocol/transaction_util.hpp>
 #include <hive/protocol/hbd_interest.hpp>
 
+#include <hive/chain/authority_cache.hpp>
 #include <hive/chain/block_summary_object.hpp>
 #include <hive/chain/compound.hpp>
 #include <hive/chain/custom_operation_interpreter.hpp>
@@ -41,6 +42,8 @@
 
 #include <hive/jsonball/jsonball.hpp>
 
+#include <hive/utilities/latency_histogram.hpp>
+
 #include <fc/smart_ref_impl.hpp>
 #include <fc/uint128.hpp>
 
@@ -128,6 +131,9 @@ class database_impl
     evaluator_registry< operation >                   _evaluator_registry;
     std::map<account_name_type, block_id_type>        _last_fast_approved_block_by_witness;
     std::unique_ptr<util::decoded_types_data_storage> _decoded_types_data_storage;
+    // latency histograms of evaluators indexed by operation type, filled on first use
+    std::vector<hive::utilities::latency_histogram*>  _evaluator_latency;
+    authority_cache                                   _authority_cache;
     
     // these used for the node_status API, which reads these values from another thread
     // they're only used to determine if the node is in sync, and nothing particulary bad
@@ -136,7 +142,8 @@ class database_impl
     std::atomic<uint32_t>                             _last_pushed_block_time = {0}; // the value from a time_point_sec
 };
 
-database_impl::database_impl( database& self ) : _self(self), _evaluator_registry(self) {}
+database_impl::database_impl( database& self ) : _self(self), _evaluator_registry(self),
+  _evaluator_latency( operation::count(), nullptr ), _authority_cache(self) {}
 
 void database_impl::register_new_type(util::abstract_type_registrar& r)
 {
@@ -2454,7 +2461,8 @@ share_type database::pay_curators( const comment_object& comment, const comment_
 }
 
 share_type database::cashout_comment_helper( util::comment_reward_context& ctx, const comment_object& comment,
-  const comment_cashout_object& comment_cashout, const comment_cashout_ex_object* comment_cashout_ex, bool forward_curation_remainder )
+  const comment_cashout_object& comment_cashout, const comment_cashout_ex_object* comment_cashout_ex, bool forward_curation_remainder,
+  fc::optional< uint128_t > reward_curve_claim )
 {
   try
   {
@@ -2476,7 +2484,7 @@ share_type database::cashout_comment_helper( util::comment_reward_context& ctx,
         ctx.content_constant = rf.content_constant;
       }
 
-      const share_type reward = util::get_rshare_reward( ctx );
+      const share_type reward = reward_curve_claim ? util::get_rshare_reward( ctx, *reward_curve_claim ) : util::get_rshare_reward( ctx );
       uint128_t reward_tokens = uint128_t( reward.value );
       share_type curation_tokens;
       share_type author_tokens;
@@ -2688,6 +2696,11 @@ void database::process_comment_cashout()
   const auto& com_by_root = get_index< comment_cashout_ex_index, by_root >();
 
   auto _current = cidx.begin();
+  // due cashouts with positive rshares, in the order payout visits them, and their reward curve claims; the claims
+  // are evaluated for the whole batch up front, the payout loop below only consumes them
+  std::vector< comment_id_type > due_comments;
+  std::vector< share_type > due_rshares;
+  std::vector< uint128_t > due_claims;
   // add all rshares about to be cashed out to the reward funds. This ensures equal satoshi per rshare payment
   if( has_hardfork( HIVE_HARDFORK_0_17__771 ) )
   {
@@ -2695,15 +2708,21 @@ void database::process_comment_cashout()
     {
       if( _current->get_net_rshares() > 0 )
       {
-        const auto& rf = get_reward_fund();
-        funds[ rf.get_id() ].recent_claims += util::evaluate_reward_curve( _current->get_net_rshares(), rf.author_reward_curve, rf.content_constant );
+        due_comments.push_back( _current->get_comment_id() );
+        due_rshares.push_back( _current->get_net_rshares() );
       }
 
       ++_current;
     }
 
+    const auto& rf = get_reward_fund();
+    due_claims = util::evaluate_reward_curve( due_rshares, rf.author_reward_curve, rf.content_constant );
+    for( const auto& claim : due_claims )
+      funds[ rf.get_id() ].recent_claims += claim;
+
     _current = cidx.begin();
   }
+  size_t next_due_claim = 0;
 
   bool forward_curation_remainder = !has_hardfork( HIVE_HARDFORK_0_20__1877 );
   /*
@@ -2732,8 +2751,12 @@ void database::process_comment_cashout()
       ctx.total_reward_fund_hive = funds[ fund_id ].reward_balance;
 
       const comment_object& _comment = get_comment( *_current );
+      fc::optional< uint128_t > reward_curve_claim;
+      if( next_due_claim < due_comments.size() && due_comments[ next_due_claim ] == _current->get_comment_id() &&
+          due_rshares[ next_due_claim ] == _current->get_net_rshares() )
+        reward_curve_claim = due_claims[ next_due_claim++ ];
       funds[ fund_id ].hive_awarded += cashout_comment_helper( ctx, _comment, *_current,
-        find_comment_cashout_ex( _comment ), forward_curation_remainder );
+        find_comment_cashout_ex( _comment ), forward_curation_remainder, reward_curve_claim );
       ++count;
 
       if( has_hardfork( HIVE_HARDFORK_0_19 ) )
@@ -4051,6 +4074,26 @@ void database::_apply_block( const std::shared_ptr<full_block_type>& full_block,
               (witness)(block.witness)(hardfork_state));
   }
 
+  if( _worker_thread_pool != nullptr &&
+      _current_tx_status != TX_STATUS_GEN_BLOCK ) // transactions of locally generated block were already verified as pending
+  {
+    // Let workers precompute state independent parts of validation for all transactions of the block ahead
+    // of the serial loop below, but only those that _apply_transaction() is going to use with current skip flags.
+    // Results are cached inside full_transaction_type, so whichever thread gets to the transaction first
+    // does the work and transactions are still applied strictly in block order.
+    uint32_t computations = 0;
+    if( !( skip & skip_validate ) )
+      computations |= blockchain_worker_thread_pool::validation;
+    if( !( skip & ( skip_transaction_signatures | skip_authority_check ) ) )
+      computations |= blockchain_worker_thread_pool::signature_keys | blockchain_worker_thread_pool::required_authorities;
+    // blocks received from p2p (or read for replay) usually have their transactions queued already by
+    // the pool, also when the block is applied again after fork switch
+    computations = full_block->mark_transaction_computations_queued( computations );
+    if( computations != 0 )
+      _worker_thread_pool->enqueue_work( full_block->get_full_transactions(),
+        blockchain_worker_thread_pool::data_source_type::transaction_inside_block_for_apply, block_num, computations );
+  }
+
   for( const std::shared_ptr<full_transaction_type>& trx : full_block->get_full_transactions() )
   {
     /* We do not need to push the undo state for each transaction
@@ -4421,10 +4464,8 @@ void database::validate_transaction(const std::shared_ptr<full_transaction_type>
 
   if (!(skip & (skip_transaction_signatures | skip_authority_check)))
   {
-    auto get_active  =    [&]( const string& name ) { return authority( get< account_authority_object, by_account >( name ).active ); };
-    auto get_owner   =    [&]( const string& name ) { return authority( get< account_authority_object, by_account >( name ).owner );  };
-    auto get_posting =    [&]( const string& name ) { return authority( get< account_authority_object, by_account >( name ).posting );  };
     auto get_witness_key = [&]( const string& name ) { try { return get_witness( name ).signing_key; } FC_CAPTURE_AND_RETHROW((name)) };
+    _my->_authority_cache.trim();
 
     try
     {
@@ -4438,17 +4479,11 @@ void database::validate_transaction(const std::shared_ptr<full_transaction_type>
                                        has_hardfork( HIVE_HARDFORK_1_28_ALLOW_REDUNDANT_SIGNATURES ),
                                        required_authorities,
                                        signature_keys,
-                                       get_active,
-                                       get_owner,
-                                       get_posting,
+                                       _my->_authority_cache,
                                        get_witness_key,
                                        HIVE_MAX_SIG_CHECK_DEPTH,
                                        has_hardfork(HIVE_HARDFORK_0_20) ? HIVE_MAX_AUTHORITY_MEMBERSHIP : 0,
-                                       has_hardfork(HIVE_HARDFORK_0_20) ? HIVE_MAX_SIG_CHECK_ACCOUNTS : 0,
-                                       false,
-                                       flat_set<account_name_type>(),
-                                       flat_set<account_name_type>(),
-                                       flat_set<account_name_type>());
+                                       has_hardfork(HIVE_HARDFORK_0_20) ? HIVE_MAX_SIG_CHECK_ACCOUNTS : 0);
 
       if (_benchmark_dumper.is_enabled())
         _benchmark_dumper.end("transaction", "verify_authority", trx.signatures.size());
@@ -4565,7 +4600,15 @@ void database::apply_operation(const operation& op)
   if( has_hardfork( HIVE_HARDFORK_0_20 ) )
     rc.handle_operation_discount< operation >( op );
 
-  _my->_evaluator_registry.get_evaluator( op ).apply( op );
+  auto& evaluator = _my->_evaluator_registry.get_evaluator( op );
+  auto*& latency = _my->_evaluator_latency[ op.which() ];
+  if( latency == nullptr )
+    latency = &hive::utilities::latency_stats::instance().get( "evaluator", evaluator.get_name( op ) );
+
+  {
+    hive::utilities::scoped_latency_timer timer( latency );
+    evaluator.apply( op );
+  }
 
   if( _benchmark_dumper.is_enabled() )
     _benchmark_dumper.end( name );
@@ -4583,14 +4626,18 @@ struct fcall<TResult(TArgs...)>
   fcall() = default;
   fcall(const TNotification& func, util::advanced_benchmark_dumper& dumper,
     const abstract_plugin& plugin, const std::string& context, const std::string& item_name)
-    : _func(func), _benchmark_dumper(dumper), _context(context), _name(item_name) {}
+    : _func(func), _benchmark_dumper(dumper), _context(context), _name(item_name),
+      _latency(&hive::utilities::latency_stats::instance().get(context, item_name)) {}
 
   void operator () (TArgs&&... args)
   {
     if (_benchmark_dumper.is_enabled())
       _benchmark_dumper.begin();
 
-    _func(std::forward<TArgs>(args)...);
+    {
+      hive::utilities::scoped_latency_timer timer( _latency );
+      _func(std::forward<TArgs>(args)...);
+    }
 
     if (_benchmark_dumper.is_enabled())
       _benchmark_dumper.end( _context, _name );
@@ -4601,6 +4648,7 @@ private:
   util::advanced_benchmark_dumper& _benchmark_dumper;
   std::string                      _context;
   std::string                      _name;
+  hive::utilities::latency_histogram* _latency = nullptr;
 };
 
 template <typename TResult, typename... TArgs>
@@ -4626,7 +4674,9 @@ boost::signals2::connection database::any_apply_operation_handler_impl( const ap
   const abstract_plugin& plugin, int32_t group )
 {
   std::string context = util::advanced_benchmark_dumper::generate_context_desc< IS_PRE_OPERATION >( plugin.get_name() );
-  auto complex_func = [this, func, &plugin, context]( const operation_notification& o )
+  // per operation type latency histograms of this handler, filled on first use
+  auto latency = std::make_shared< std::vector< hive::utilities::latency_histogram* > >( operation::count(), nullptr );
+  auto complex_func = [this, func, &plugin, context, latency]( const operation_notification& o )
   {
     std::string name;
 
@@ -4636,7 +4686,14 @@ boost::signals2::connection database::any_apply_operation_handler_impl( const ap
       _benchmark_dumper.begin();
     }
 
-    func( o );
+    auto*& op_latency = ( *latency )[ o.op.which() ];
+    if( op_latency == nullptr )
+      op_latency = &hive::utilities::latency_stats::instance().get( context, o.op.get_stored_type_name() );
+
+    {
+      hive::utilities::scoped_latency_timer timer( op_latency );
+      func( o );
+    }
 
     if (_benchmark_dumper.is_enabled())
       _benchmark_dumper.end( context, name );
@@ -6863,6 +6920,11 @@ void database::set_block_writer( block_write_i* writer )
   _block_writer = writer;
 }
 
+void database::set_worker_thread_pool( blockchain_worker_thread_pool* thread_pool )
+{
+  _worker_thread_pool = thread_pool;
+}
+
 database::node_status_t database::get_node_status()
 {
   node_status_t result;
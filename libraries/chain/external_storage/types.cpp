@@ -53,6 +53,13 @@ bool CachableWriteBatch::getAHInfo(const account_name_type& name, account_histor
     return true;
   }
 
+  fi = _detachedAhInfoCache.find(name);
+  if(fi != _detachedAhInfoCache.end())
+  {
+    *ahInfo = fi->second;
+    return true;
+  }
+
   ah_info_by_name_slice_t key(name.data);
   PinnableSlice buffer;
   auto s = _storage->Get(ReadOptions(), _columnHandles[Columns::AH_INFO_BY_NAME], key, &buffer);
@@ -81,6 +88,20 @@ void CachableWriteBatch::Clear()
   WriteBatch::Clear();
 }
 
+void CachableWriteBatch::detach(WriteBatch& target)
+{
+  FC_ASSERT(_detachedAhInfoCache.empty(), "Previously detached batch has not been released yet");
+
+  target = static_cast<const WriteBatch&>(*this);
+  _detachedAhInfoCache.swap(_ahInfoCache);
+  WriteBatch::Clear();
+}
+
+void CachableWriteBatch::releaseDetached()
+{
+  _detachedAhInfoCache.clear();
+}
+
 void registerSnapshotComparators() {
   static std::once_flag registered;
   std::call_once(registered, []() {
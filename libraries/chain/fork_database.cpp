@@ -14,6 +14,8 @@ void fork_database::reset()
   with_write_lock( [&]() {
     _head.reset();
     _index.clear();
+    _main_branch.clear();
+    _main_branch_first_num = 0;
   });
 }
 
@@ -24,6 +26,7 @@ void fork_database::pop_block()
     auto prev = _head->prev.lock();
     FC_ASSERT( prev, "popping head block would leave fork DB empty" );
     _head = prev;
+    _update_main_branch();
   });
 }
 
@@ -33,6 +36,7 @@ void fork_database::start_block(const std::shared_ptr<full_block_type>& full_blo
   with_write_lock([&]() {
     _index.insert(item);
     _head = item;
+    _update_main_branch();
   });
 }
 
@@ -46,6 +50,7 @@ shared_ptr<fork_item> fork_database::push_block(const std::shared_ptr<full_block
     try 
     {
       _push_block(item);
+      _update_main_branch();
     }
     catch (const unlinkable_block_exception&)
     {
@@ -98,6 +103,42 @@ void fork_database::_push_block(const item_ptr& item)
   _push_next(item); // check for any unlinked blocks that can now be linked to our fork
 }
 
+void fork_database::_update_main_branch()
+{
+  // walk back from the head until we reach a block that is already in its place on the main branch;
+  // in the common case (head extended by one block or popped) that takes a single step
+  std::vector<item_ptr> new_items;
+  item_ptr item = _head;
+  while( item )
+  {
+    const uint32_t num = item->get_block_num();
+    if( num >= _main_branch_first_num && num - _main_branch_first_num < _main_branch.size() &&
+        _main_branch[ num - _main_branch_first_num ] == item )
+      break;
+    new_items.push_back( item );
+    item = item->prev.lock();
+  }
+
+  if( item )
+  {
+    _main_branch.resize( item->get_block_num() - _main_branch_first_num + 1 );
+  }
+  else
+  {
+    // no common part with previous main branch (or no head at all)
+    _main_branch.clear();
+    _main_branch_first_num = new_items.empty() ? 0 : new_items.back()->get_block_num();
+  }
+  _main_branch.insert( _main_branch.end(), new_items.rbegin(), new_items.rend() );
+}
+
+item_ptr fork_database::_fetch_main_branch_item_unlocked( uint32_t block_num )const
+{
+  if( block_num < _main_branch_first_num || block_num - _main_branch_first_num >= _main_branch.size() )
+    return item_ptr();
+  return _main_branch[ block_num - _main_branch_first_num ];
+}
+
 shared_ptr<fork_item> fork_database::head()const 
 {
   return with_read_lock( [&]() { return _head; } );
@@ -150,6 +191,14 @@ void fork_database::set_max_size( uint32_t s )
     if( !_head ) return;
     //wlog("set_max_size(${s}), head is ${head}, erasing <= ${thresh}", (s)("head", _head->num)("thresh", _head->num - s));
   
+    { /// main branch
+      while( !_main_branch.empty() &&
+             _main_branch_first_num <= std::max(int64_t(0),int64_t(_head->get_block_num()) - _max_size) )
+      {
+        _main_branch.pop_front();
+        ++_main_branch_first_num;
+      }
+    }
     { /// index
       auto& by_num_idx = _index.get<block_num>();
       auto itr = by_num_idx.begin();
@@ -335,13 +384,8 @@ pair<fork_database::branch_type,fork_database::branch_type> fork_database::fetch
 
 shared_ptr<fork_item> fork_database::walk_main_branch_to_num_unlocked( uint32_t block_num )const
 {
-  shared_ptr<fork_item> next = _head; //don't call head(), we already have a read lock
-  if( block_num > next->get_block_num() )
-    return shared_ptr<fork_item>();
-
-  while( next.get() != nullptr && next->get_block_num() > block_num )
-    next = next->prev.lock();
-  return next;
+  // main branch holds exactly the blocks reachable from _head, so no need to actually walk
+  return _fetch_main_branch_item_unlocked( block_num );
 }
 
 shared_ptr<fork_item> fork_database::walk_main_branch_to_num( uint32_t block_num )const
@@ -362,6 +406,9 @@ shared_ptr<fork_item> fork_database::fetch_block_on_main_branch_by_number_unlock
 {
   if (!_head || block_num > _head->get_block_num())
     return shared_ptr<fork_item>();
+  item_ptr main_branch_item = _fetch_main_branch_item_unlocked(block_num);
+  if (main_branch_item)
+    return main_branch_item;
   vector<item_ptr> blocks = fetch_block_by_number_unlocked(block_num);
   if( blocks.size() == 1 )
     return blocks[0];
@@ -385,26 +432,16 @@ vector<fork_item> fork_database::fetch_block_range_on_main_branch_by_number( con
     // but if the head block isn't to last_desired_block_num yet, the latest we can have is the head block
     const uint32_t last_block_num = std::min(last_desired_block_num, _head->get_block_num());
   
-    // look up that last block and see if we have it
-    const auto& block_num_idx = _index.get<block_num>();
-    const auto fork_items_for_last_block_num = boost::make_iterator_range(block_num_idx.equal_range(last_block_num));
-    // if we don't have it (it has already been moved to the block log), return an empty list
-    if (fork_items_for_last_block_num.empty())
+    // if we don't have that last block (it has already been moved to the block log), return an empty list
+    if (!_fetch_main_branch_item_unlocked(last_block_num))
       return results;
     
-    // otherwise, walk backwards from that block, collecting blocks along the way.  Stop when
-    // we either reach the first block the caller asked for, or we run out of blocks in the fork database
-    shared_ptr<fork_item> item;
-    if (std::next(fork_items_for_last_block_num.begin()) == fork_items_for_last_block_num.end()) // if exactly one block numbered last_block_num
-      item = fork_items_for_last_block_num.front();
-    else
-      item = walk_main_branch_to_num_unlocked(last_block_num);
-  
-    for (; item && item->get_block_num() >= first_block_num; item = item->prev.lock())
-      results.push_back(*item);
-  
-    // we collected the blocks in descending order, reverse that order
-    boost::reverse(results);
+    // otherwise collect blocks from the main branch, starting from the first block the caller asked for
+    // or the oldest block we have in the fork database
+    const uint32_t first_available_block_num = std::max(first_block_num, _main_branch_first_num);
+    results.reserve(last_block_num - first_available_block_num + 1);
+    for (uint32_t num = first_available_block_num; num <= last_block_num; ++num)
+      results.push_back(*_main_branch[num - _main_branch_first_num]);
   
     return results;
   }, wait_for_microseconds);
@@ -414,6 +451,7 @@ void fork_database::set_head(shared_ptr<fork_item> h)
 {
   with_write_lock( [&]() {
     _head = std::move( h );
+    _update_main_branch();
   });
 }
 
@@ -429,7 +467,27 @@ void fork_database::remove(block_id_type id)
   with_write_lock( [&]() {
     if (_head && _head->get_block_id() == id)
       _head = _head->prev.lock();
-    _index.get<block_id>().erase(id);
+    auto& index = _index.get<block_id>();
+    auto itr = index.find(id);
+    item_ptr removed_item;
+    if (itr != index.end())
+    {
+      // drop main branch from removed block up, so it no longer keeps the block alive
+      removed_item = *itr;
+      const uint32_t num = removed_item->get_block_num();
+      if (_fetch_main_branch_item_unlocked(num) == removed_item)
+        _main_branch.resize(num - _main_branch_first_num);
+      index.erase(itr);
+    }
+    _update_main_branch();
+    // when the caller still holds the removed block, the walk above links through it again; cut the main
+    // branch right above it, where walking prev links stops once the block is released
+    if (removed_item && _fetch_main_branch_item_unlocked(removed_item->get_block_num()) == removed_item)
+    {
+      const uint32_t num = removed_item->get_block_num();
+      _main_branch.erase(_main_branch.begin(), _main_branch.begin() + (num - _main_branch_first_num + 1));
+      _main_branch_first_num = num + 1;
+    }
   });
 }
 
@@ -499,27 +557,36 @@ std::vector<block_id_type> fork_database::get_blockchain_synopsis(block_id_type
     uint32_t low_block_num = last_irreversible_block_num ? last_irreversible_block_num : 1;
 
 
-    // the node is asking for a summary of the block chain up to the reference
-    // block, and the reference block should be in the fork database
-    const auto& block_id_index = _index.get<block_id>();
-    auto reference_point_iter = block_id_index.find(reference_point);
-    if (reference_point_iter == block_id_index.end())
-    {
-      // we've got a problem: the block number indicates the block should 
-      // be in the fork database, but it's not.  A well-behaved peer
-      // shouldn't cause this situation
-      // maybe throw here???
-      //edump((last_irreversible_block_num)(reference_point_block_num)(_head->get_block_id())(reference_point));
-      FC_THROW("Unable to construct a useful synopsis because we can't find the reference block in the fork database");
-    }
+    // the usual case is a reference point on our main branch - then we can pick synopsis entries
+    // directly from it instead of walking the whole fork
+    const item_ptr main_branch_item = _fetch_main_branch_item_unlocked(reference_point_block_num);
+    const bool reference_point_on_main_branch = main_branch_item && main_branch_item->get_block_id() == reference_point &&
+                                                _main_branch_first_num == last_irreversible_block_num;
 
     std::vector<block_id_type> block_ids_on_this_fork;
 
-    item_ptr next = *reference_point_iter;
-    while (next.get())
+    if (!reference_point_on_main_branch)
     {
-      block_ids_on_this_fork.push_back(next->get_block_id());
-      next = next->prev.lock();
+      // the node is asking for a summary of the block chain up to the reference
+      // block, and the reference block should be in the fork database
+      const auto& block_id_index = _index.get<block_id>();
+      auto reference_point_iter = block_id_index.find(reference_point);
+      if (reference_point_iter == block_id_index.end())
+      {
+        // we've got a problem: the block number indicates the block should 
+        // be in the fork database, but it's not.  A well-behaved peer
+        // shouldn't cause this situation
+        // maybe throw here???
+        //edump((last_irreversible_block_num)(reference_point_block_num)(_head->get_block_id())(reference_point));
+        FC_THROW("Unable to construct a useful synopsis because we can't find the reference block in the fork database");
+      }
+
+      item_ptr next = *reference_point_iter;
+      while (next.get())
+      {
+        block_ids_on_this_fork.push_back(next->get_block_id());
+        next = next->prev.lock();
+      }
     }
 
     // block_ids_on_this_fork now contains
@@ -535,7 +602,10 @@ std::vector<block_id_type> fork_database::get_blockchain_synopsis(block_id_type
     //idump((low_block_num)(reference_point_block_num)(true_high_block_num));
     do
     {
-      synopsis.push_back(block_ids_on_this_fork[block_ids_on_this_fork.size() - (low_block_num - last_irreversible_block_num) - 1]);
+      if (reference_point_on_main_branch)
+        synopsis.push_back(_main_branch[low_block_num - _main_branch_first_num]->get_block_id());
+      else
+        synopsis.push_back(block_ids_on_this_fork[block_ids_on_this_fork.size() - (low_block_num - last_irreversible_block_num) - 1]);
       low_block_num += (true_high_block_num - low_block_num + 2) / 2;
     }
     while (low_block_num <= reference_point_block_num);
@@ -102,6 +102,21 @@ full_block_type::~full_block_type()
 /* static */ std::shared_ptr<full_block_type> full_block_type::create_from_block_header_and_transactions(const block_header& header, 
                                                                                                          const std::vector<std::shared_ptr<full_transaction_type>>& full_transactions,
                                                                                                          const fc::ecc::private_key* signer)
+{
+  signed_block_header unsigned_header;
+  (block_header&)unsigned_header = header;
+  return create_from_header_and_transactions(unsigned_header, full_transactions, signer);
+}
+
+/* static */ std::shared_ptr<full_block_type> full_block_type::create_from_signed_block_header_and_transactions(const signed_block_header& header, 
+                                                                                                                const std::vector<std::shared_ptr<full_transaction_type>>& full_transactions)
+{
+  return create_from_header_and_transactions(header, full_transactions, nullptr);
+}
+
+/* static */ std::shared_ptr<full_block_type> full_block_type::create_from_header_and_transactions(const signed_block_header& header, 
+                                                                                                   const std::vector<std::shared_ptr<full_transaction_type>>& full_transactions,
+                                                                                                   const fc::ecc::private_key* signer)
 { try {
   std::shared_ptr<full_block_type> full_block = std::make_shared<full_block_type>();
 
@@ -112,7 +127,7 @@ full_block_type::~full_block_type()
 
   decoded_block_storage->block = signed_block();
   signed_block& new_block = *decoded_block_storage->block; // alias to keep things shorter
-  (block_header&)new_block = header;
+  (signed_block_header&)new_block = header;
   //fc::time_point compute_begin = fc::time_point::now();
   full_block->merkle_root = compute_merkle_root(full_transactions);
   //fc::time_point compute_end = fc::time_point::now();
@@ -302,6 +317,12 @@ const compressed_block_data& full_block_type::get_alternate_compressed_block() c
   return alternate_compressed_block;
 }
 
+/* static */ block_id_type full_block_type::compute_block_id(const signed_block_header& header)
+{
+  std::vector<char> serialized_header = fc::raw::pack_to_vector(header);
+  return construct_block_id(serialized_header.data(), serialized_header.size(), header.block_num());
+}
+
 /* static */ block_id_type full_block_type::construct_block_id(const char* signed_block_header_begin, size_t signed_block_header_size, uint32_t block_num)
 {
   // to get the block id, we start by taking the hash of the header
@@ -481,6 +502,16 @@ bool full_block_type::has_decoded_block_id() const
   return has_block_id.load(std::memory_order_consume);
 }
 
+bool full_block_type::has_decoded_block() const
+{
+  return has_unpacked_block.load(std::memory_order_consume);
+}
+
+uint32_t full_block_type::mark_transaction_computations_queued(uint32_t computations) const
+{
+  return computations & ~queued_transaction_computations.fetch_or(computations, std::memory_order_relaxed);
+}
+
 
 void full_block_type::compute_legacy_block_message_hash() const
 {
@@ -559,6 +559,27 @@ void full_transaction_cache::remove_from_cache(const hive::protocol::digest_type
   my->digests_to_delete.push(merkle_digest);
 }
 
+full_transaction_ptr full_transaction_cache::find_by_merkle_digest_prefix(uint64_t prefix)
+{
+  // the cache is ordered by digest bytes, so all transactions sharing the prefix are adjacent
+  hive::protocol::digest_type lowest_matching_digest;
+  memcpy(lowest_matching_digest.data(), &prefix, sizeof(prefix));
+
+  std::lock_guard<std::mutex> lock(my->cache_mutex);
+  full_transaction_ptr result;
+  for (auto iter = my->cache.lower_bound(lowest_matching_digest);
+       iter != my->cache.end() && memcmp(iter->first.data(), &prefix, sizeof(prefix)) == 0; ++iter)
+  {
+    full_transaction_ptr transaction = iter->second.lock();
+    if (!transaction)
+      continue;
+    if (result)
+      return full_transaction_ptr(); // ambiguous prefix, caller has to get the transaction some other way
+    result = std::move(transaction);
+  }
+  return result;
+}
+
 /* static */ full_transaction_cache& full_transaction_cache::get_instance()
 {
   static full_transaction_cache the_cache;
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <hive/protocol/transaction_util.hpp>
+
+#include <chainbase/chainbase.hpp>
+
+#include <unordered_map>
+
+namespace hive { namespace chain {
+
+  using hive::protocol::authority;
+  using hive::protocol::account_name_type;
+
+  /**
+    *  Keeps authorities of accounts converted from their shared memory form, so verification of transactions
+    *  signed by the same popular accounts does not rebuild them from account_authority_object every time.
+    *  Each cached authority is compared with the state before it is returned (which does not allocate), so
+    *  the cache stays correct through any modification or undo of account_authority_object without hooks.
+    *  References returned stay valid until \see trim is called, which must not happen during verification.
+    */
+  class authority_cache : public hive::protocol::authority_ref_getter_i
+  {
+    public:
+      static constexpr size_t max_cached_accounts = 100000;
+
+      explicit authority_cache( const chainbase::database& db ) : _db( db ) {}
+
+      const authority& get_active( const std::string& name ) override;
+      const authority& get_owner( const std::string& name ) override;
+      const authority& get_posting( const std::string& name ) override;
+
+      /// drops all cached authorities when there are too many of them
+      void trim();
+      void clear() { _entries.clear(); }
+      size_t size() const { return _entries.size(); }
+
+    private:
+      struct entry
+      {
+        authority owner;
+        authority active;
+        authority posting;
+        bool      has_owner = false;
+        bool      has_active = false;
+        bool      has_posting = false;
+      };
+
+      template< typename GET_SHARED_AUTHORITY >
+      const authority& get( const std::string& name, bool entry::*has_authority, authority entry::*cached_authority,
+        GET_SHARED_AUTHORITY get_shared_authority );
+
+      const chainbase::database&                    _db;
+      std::unordered_map< account_name_type, entry > _entries;
+  };
+
+} } // hive::chain
@@ -1,4 +1,9 @@
+#pragma once
+#include <fc/filesystem.hpp>
+
 #include <cstdint>
+#include <memory>
+#include <optional>
 
 extern "C"
 {
@@ -13,4 +18,23 @@ namespace hive { namespace chain {
   std::optional<uint8_t> get_last_available_zstd_compression_dictionary_number();
   ZSTD_CDict* get_zstd_compression_dictionary(uint8_t dictionary_number, int compression_level);
   ZSTD_DDict* get_zstd_decompression_dictionary(uint8_t dictionary_number);
+
+  // Dictionaries trained locally from recent blocks (see compress_block_log --train-dictionary) are stored as
+  // files next to the block log and use numbers from first_local_zstd_compression_dictionary_number up.
+  // They are never announced to peers, so blocks compressed with them are recompressed before being sent over p2p.
+  constexpr uint8_t first_local_zstd_compression_dictionary_number = 224;
+  fc::path get_local_zstd_compression_dictionary_file_name(uint8_t dictionary_number, uint32_t first_block_number);
+  // loads all local dictionary files found in given directory; ones already loaded are skipped, but a different
+  // dictionary under a number that is already in use is an error
+  void load_local_zstd_compression_dictionaries(const fc::path& directory);
+  // blocks compressed with a local dictionary can't be read without its file, so tools that move blocks to
+  // another directory in their compressed form (split, merge) have to bring the dictionary files along
+  void copy_local_zstd_compression_dictionaries(const fc::path& source_directory, const fc::path& destination_directory);
+  void add_local_zstd_compression_dictionary(uint8_t dictionary_number, uint32_t first_block_number,
+                                             std::unique_ptr<char[]>&& dictionary_data, size_t dictionary_size);
+  // local dictionary trained on the closest range starting at or below given block (if any)
+  std::optional<uint8_t> get_local_zstd_compression_dictionary_number_for_block(uint32_t block_number);
+  std::optional<uint8_t> get_next_free_local_zstd_compression_dictionary_number();
+  // true for built-in dictionaries and for local ones that are loaded
+  bool is_known_zstd_compression_dictionary_number(uint8_t dictionary_number);
 } }
@@ -112,7 +112,8 @@ namespace hive { namespace chain {
                           bool enable_compression,
                           int compression_level,
                           bool enable_block_log_auto_fixing, 
-                          hive::chain::blockchain_worker_thread_pool& thread_pool );
+                          hive::chain::blockchain_worker_thread_pool& thread_pool,
+                          bool cache_recent_blocks = false );
       void close();
       bool is_open()const;
 
@@ -170,6 +171,8 @@ namespace hive { namespace chain {
       void truncate(uint32_t new_head_block_num);
     private:
       void sanity_check(const bool read_only);
+      std::shared_ptr<full_block_type> read_block_by_num(uint32_t block_num, bool use_cache) const;
+      std::shared_ptr<full_block_type> read_block_by_num_from_disk(uint32_t block_num) const;
       std::unique_ptr<detail::block_log_impl> my;
 
       appbase::application& theApp;
@@ -45,6 +45,8 @@ namespace hive { namespace chain {
       bool      enable_block_log_compression = true;
       int       block_log_compression_level = 15;
       bool      enable_block_log_auto_fixing = true;
+      // keep recently read blocks decoded for p2p and API readers; tools reading the log sequentially leave it off
+      bool      cache_recent_blocks = false;
       bool      load_snapshot = false;
       bool      replay = false;
       bool      force_replay = false;
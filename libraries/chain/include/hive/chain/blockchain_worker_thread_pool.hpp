@@ -52,6 +52,7 @@ public:
     block_received_from_p2p,
     transaction_inside_block_received_from_p2p,
     transaction_inside_block_for_replay,
+    transaction_inside_block_for_apply,
     standalone_transaction_received_from_p2p,
     standalone_transaction_received_from_api,
     locally_produced_block,
@@ -62,10 +63,21 @@ public:
     block_log_for_decompressing,
     block_log_for_artifact_generation
   };
+  // state independent parts of transaction verification that workers can precompute for transactions
+  // of a block; used as bit set, so a block only gets the work its validation actually needs
+  enum transaction_computation : uint32_t
+  {
+    validation = 0x1,
+    signature_keys = 0x2,
+    required_authorities = 0x4,
+    all_transaction_computations = validation | signature_keys | required_authorities
+  };
+
   void enqueue_work(const std::shared_ptr<full_block_type>& full_block, data_source_type data_source);
   void enqueue_work(const std::shared_ptr<full_transaction_type>& full_transaction, data_source_type data_source);
+  // computations are only used by transaction_inside_block_received_from_p2p and transaction_inside_block_for_apply
   void enqueue_work(const std::vector<std::shared_ptr<full_transaction_type>>& full_transactions, data_source_type data_source,
-                    std::optional<uint32_t> block_number);
+                    std::optional<uint32_t> block_number, uint32_t computations = all_transaction_computations);
 
   void set_p2p_force_validate();
   void set_validate_during_replay();
@@ -115,6 +115,8 @@ namespace chain {
       ~database();
 
       void set_block_writer( block_write_i* writer );
+      /// when set, stateless parts of transaction validation of applied blocks are precomputed on pool's workers
+      void set_worker_thread_pool( blockchain_worker_thread_pool* thread_pool );
 
       enum transaction_status
       {
@@ -527,7 +529,7 @@ namespace chain {
       share_type pay_curators( const comment_object& comment, const comment_cashout_object& comment_cashout, share_type& max_rewards );
       share_type cashout_comment_helper( util::comment_reward_context& ctx, const comment_object& comment,
         const comment_cashout_object& comment_cashout, const comment_cashout_ex_object* comment_cashout_ex,
-        bool forward_curation_remainder = true );
+        bool forward_curation_remainder = true, fc::optional< fc::uint128_t > reward_curve_claim = fc::optional< fc::uint128_t >() );
       void process_comment_cashout();
       void process_funds();
       void process_conversions();
@@ -799,6 +801,8 @@ namespace chain {
 
       block_write_i*                _block_writer;
 
+      blockchain_worker_thread_pool* _worker_thread_pool = nullptr;
+
       // this function needs access to _plugin_index_signal
       template< typename MultiIndexType >
       friend void add_plugin_index( database& db );
@@ -1,8 +1,13 @@
 #pragma once
 
+#include <hive/chain/account_object.hpp>
 #include <hive/chain/database.hpp>
+#include <hive/chain/rc/resource_user.hpp>
 #include <boost/scope_exit.hpp>
 
+#include <map>
+#include <optional>
+
 /*
   * This file provides with() functions which modify the database
   * temporarily, then restore it.  These functions are mostly internal
@@ -102,6 +107,82 @@ struct pending_transactions_restorer
     uint32_t dropped_txs = 0;
     bool stop = false;
 
+    // RC payers whose transaction failed for lack of RC during this pass. Their other transactions that cost
+    // at least as much RC as the cheapest failed one (as measured during their previous execution) are not
+    // re-executed but postponed, so they are retried after next block. Transactions that cost less might still
+    // fit in what is left, so those are executed normally, and so are all transactions of the payer once payer's
+    // RC changed (f.e. RC delegation or power up from other pending transaction). RC cost depends mostly on
+    // operation types and not on transaction size, and the cost of postponed transaction might change with new
+    // RC prices, that's why they are not dropped
+    struct rc_drained_payer
+    {
+      int64_t    current_mana = 0;
+      uint32_t   last_update_time = 0;
+      share_type max_rc;
+      int64_t    cheapest_failed_rc_cost = 0;
+    };
+    std::map<account_name_type, rc_drained_payer> rc_drained_payers;
+
+    auto get_rc_state = [&](const account_name_type& payer) -> std::optional<rc_drained_payer>
+    {
+      const account_object* account = _db.find_account( payer );
+      if( account == nullptr )
+        return std::optional<rc_drained_payer>();
+      return rc_drained_payer{ account->rc_manabar.current_mana, account->rc_manabar.last_update_time, account->get_maximum_rc() };
+    };
+
+    auto is_rc_drained = [&](const std::shared_ptr<full_transaction_type>& full_transaction)
+    {
+      if( rc_drained_payers.empty() )
+        return false;
+      auto drained_itr = rc_drained_payers.find( get_resource_user( full_transaction->get_transaction() ) );
+      if( drained_itr == rc_drained_payers.end() )
+        return false;
+      // negative cost means transaction was never executed, so we don't know how much it needs
+      const int64_t rc_cost = full_transaction->get_rc_cost();
+      if( rc_cost < 0 || rc_cost < drained_itr->second.cheapest_failed_rc_cost )
+        return false;
+      auto current = get_rc_state( drained_itr->first );
+      return current && current->current_mana == drained_itr->second.current_mana &&
+        current->last_update_time == drained_itr->second.last_update_time && current->max_rc == drained_itr->second.max_rc;
+    };
+
+    auto mark_rc_drained = [&](const std::shared_ptr<full_transaction_type>& full_transaction)
+    {
+      account_name_type payer = get_resource_user( full_transaction->get_transaction() );
+      auto current = get_rc_state( payer );
+      if( !current )
+        return;
+      // RC cost was set by failed execution just before the payer was found to lack RC for it
+      const int64_t rc_cost = full_transaction->get_rc_cost();
+      if( rc_cost < 0 )
+        return;
+      auto drained_itr = rc_drained_payers.find( payer );
+      current->cheapest_failed_rc_cost = rc_cost;
+      if( drained_itr != rc_drained_payers.end() && drained_itr->second.current_mana == current->current_mana &&
+          drained_itr->second.last_update_time == current->last_update_time && drained_itr->second.max_rc == current->max_rc )
+        current->cheapest_failed_rc_cost = std::min( current->cheapest_failed_rc_cost, drained_itr->second.cheapest_failed_rc_cost );
+      rc_drained_payers[ payer ] = *current;
+    };
+
+    auto postpone_tx = [&](const std::shared_ptr<full_transaction_type>& full_transaction)
+    {
+      if( _db._pending_tx_size >= _db._max_mempool_size )
+      {
+        stop = true; // too many transactions in mempool - stop rewriting postponed transactions and just drop them
+      }
+      else
+      {
+        _db._pending_tx.emplace_back(full_transaction);
+        _db._pending_tx_size += full_transaction->get_transaction_size();
+        // NOTE: while recording all postponed in _pending_tx_index would slow us down in a minor
+        // way (another 200-300ms per 1M transactions which would already likely exceed flood limits)
+        // checking against known transactions from blocks could be too slow (because they can be
+        // a lot more numerous, especially with big blocks and 1 day expiration limit)
+        ++postponed_txs;
+      }
+    };
+
     auto handle_tx = [&](const std::shared_ptr<full_transaction_type>& full_transaction)
     {
 #if !defined IS_TEST_NET || defined NDEBUG //during debugging that limit is highly problematic
@@ -121,6 +202,10 @@ struct pending_transactions_restorer
           {
             ++known_txs; // transaction already part of block
           }
+          else if( is_rc_drained( full_transaction ) )
+          {
+            postpone_tx( full_transaction ); // would most likely fail for lack of RC again
+          }
           else
           {
             // since push_transaction() takes a signed_transaction,
@@ -131,6 +216,7 @@ struct pending_transactions_restorer
         }
         catch( const not_enough_rc_exception& e )
         {
+          mark_rc_drained( full_transaction );
           ++failed_txs;
         }
         catch( const transaction_check_exception& e )
@@ -154,20 +240,7 @@ struct pending_transactions_restorer
       }
       else
       {
-        if( _db._pending_tx_size >= _db._max_mempool_size )
-        {
-          stop = true; // too many transactions in mempool - stop rewriting postponed transactions and just drop them
-        }
-        else
-        {
-          _db._pending_tx.emplace_back(full_transaction);
-          _db._pending_tx_size += full_transaction->get_transaction_size();
-          // NOTE: while recording all postponed in _pending_tx_index would slow us down in a minor
-          // way (another 200-300ms per 1M transactions which would already likely exceed flood limits)
-          // checking against known transactions from blocks could be too slow (because they can be
-          // a lot more numerous, especially with big blocks and 1 day expiration limit)
-          ++postponed_txs;
-        }
+        postpone_tx( full_transaction );
       }
     };
 
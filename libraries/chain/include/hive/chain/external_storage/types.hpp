@@ -293,10 +293,16 @@ public:
 
   void Clear();
 
+  /// Moves collected updates into `target` (to be written in background) and starts collecting a new batch.
+  /// AH info records held by the detached batch stay visible to getAHInfo until releaseDetached is called.
+  void detach(WriteBatch& target);
+  void releaseDetached();
+
 private:
   const std::unique_ptr<DB>&                        _storage;
   const std::vector<ColumnFamilyHandle*>&           _columnHandles;
   std::map<account_name_type, account_history_info> _ahInfoCache;
+  std::map<account_name_type, account_history_info> _detachedAhInfoCache;
 };
 
 } } // hive::chain
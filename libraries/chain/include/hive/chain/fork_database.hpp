@@ -10,6 +10,8 @@
 
 #include <chainbase/chainbase.hpp>
 
+#include <deque>
+
 namespace hive { namespace chain {
 
   using hive::protocol::account_name_type;
@@ -203,12 +205,19 @@ namespace hive { namespace chain {
       /** @return a pointer to the newly pushed item */
       void _push_block(const item_ptr& b );
       void _push_next(const item_ptr& newly_inserted);
+      /// brings _main_branch in line with the current _head (only touches blocks above the fork point)
+      void _update_main_branch();
+      item_ptr _fetch_main_branch_item_unlocked(uint32_t block_num)const;
 
       uint32_t                 _max_size = 1024;
 
       fork_multi_index_type    _unlinked_index;
       fork_multi_index_type    _index;
       item_ptr                 _head;
+
+      /// blocks from oldest linked block up to _head, indexed by block number - _main_branch_first_num
+      std::deque<item_ptr>     _main_branch;
+      uint32_t                 _main_branch_first_num = 0;
   };
 
 } } // hive::chain
@@ -92,6 +92,9 @@ class full_block_type
     mutable std::vector<std::shared_ptr<full_transaction_type>> full_transactions; // only valid when has_unpacked_block
     mutable fc::microseconds decode_block_time; // only valid when has_unpacked_block
 
+    // blockchain_worker_thread_pool::transaction_computation bits already queued for full_transactions
+    mutable std::atomic<uint32_t> queued_transaction_computations = { 0 };
+
     mutable std::mutex block_signing_key_merkle_root_mutex;
     mutable std::optional<fc::ecc::public_key> block_signing_key;
     mutable bool block_signing_key_accessed = false;
@@ -107,6 +110,10 @@ class full_block_type
 
     fc::ecc::public_key signee(const signature_type& witness_signature, const digest_type& digest) const;
 
+    static std::shared_ptr<full_block_type> create_from_header_and_transactions(const signed_block_header& header,
+                                                                                const std::vector<std::shared_ptr<full_transaction_type>>& full_transactions,
+                                                                                const fc::ecc::private_key* signer);
+
   public:
     full_block_type();
     ~full_block_type();
@@ -122,8 +129,14 @@ class full_block_type
     static std::shared_ptr<full_block_type> create_from_block_header_and_transactions(const block_header& header, 
                                                                                       const std::vector<std::shared_ptr<full_transaction_type>>& full_transactions,
                                                                                       const fc::ecc::private_key* signer);
+    /// rebuilds block from its already signed header (merkle root is recomputed from given transactions)
+    static std::shared_ptr<full_block_type> create_from_signed_block_header_and_transactions(const signed_block_header& header,
+                                                                                             const std::vector<std::shared_ptr<full_transaction_type>>& full_transactions);
+    /// id of a block with given header (without building the whole block)
+    static block_id_type compute_block_id(const signed_block_header& header);
 
     void decode_block() const; // immediately decompresses & unpacks the block, called by the worker thread
+    bool has_decoded_block() const; // true when decode_block() already finished (does not block)
     const signed_block& get_block() const;
     void decode_block_header() const;
     const signed_block_header& get_block_header() const;
@@ -148,6 +161,8 @@ class full_block_type
     const compressed_block_data& get_alternate_compressed_block() const;
 
     const std::vector<std::shared_ptr<full_transaction_type>>& get_full_transactions() const;
+    /// marks given computations as queued for transactions of the block, returns the ones that were not queued before
+    uint32_t mark_transaction_computations_queued(uint32_t computations) const;
     static checksum_type compute_merkle_root(const std::vector<std::shared_ptr<full_transaction_type>>& full_transactions);
     void compute_merkle_root() const;
     const checksum_type& get_merkle_root() const;
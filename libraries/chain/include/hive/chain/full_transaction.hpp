@@ -171,6 +171,8 @@ class full_transaction_cache
 public:
   full_transaction_ptr add_to_cache(const full_transaction_ptr& transaction);
   void remove_from_cache(const hive::protocol::digest_type& merkle_digest);
+  /// finds live transaction whose merkle digest starts with given 8 bytes (empty result when there is none or more than one)
+  full_transaction_ptr find_by_merkle_digest_prefix(uint64_t prefix);
 
   static full_transaction_cache& get_instance();
 };
@@ -11,6 +11,8 @@
 
 #include <fc/uint128.hpp>
 
+#include <vector>
+
 namespace hive { namespace chain { namespace util {
 
 using hive::protocol::asset;
@@ -32,6 +34,8 @@ struct comment_reward_context
 };
 
 uint64_t get_rshare_reward( const comment_reward_context& ctx );
+// same as above, with the reward curve already evaluated on ctx.rshares
+uint64_t get_rshare_reward( const comment_reward_context& ctx, const uint128_t& reward_curve_claim );
 
 inline uint128_t get_content_constant_s()
 {
@@ -39,6 +43,8 @@ inline uint128_t get_content_constant_s()
 }
 
 uint128_t evaluate_reward_curve( const uint128_t& rshares, const protocol::curve_id& curve = protocol::quadratic, const uint128_t& var1 = HIVE_CONTENT_CONSTANT_HF0 );
+// evaluates the curve for a whole batch of rshares; large batches are split between several threads
+std::vector< uint128_t > evaluate_reward_curve( const std::vector< share_type >& rshares, const protocol::curve_id& curve, const uint128_t& var1 );
 
 inline bool is_comment_payout_dust( const price& p, uint64_t hive_payout )
 {
@@ -1,6 +1,7 @@
 #include <hive/chain/split_block_log.hpp>
 #include <hive/chain/block_log.hpp>
 #include <hive/chain/block_log_wrapper.hpp>
+#include <hive/chain/block_compression_dictionaries.hpp>
 
 namespace hive { namespace chain {
 
@@ -57,6 +58,9 @@ void split_block_log( fc::path monolith_path, uint32_t head_block_number, size_t
       "Conflicting block log part file ${f} found.", ("f", *it) );
   }
 
+  // blocks are copied in their compressed form, so they still need the local dictionaries they were compressed with
+  copy_local_zstd_compression_dictionaries( monolith_path.parent_path(), output_path );
+
   ilog( "Opening split block log as target." );
   auto split_log = block_log_wrapper::create_limited_wrapper( output_path, app, thread_pool,
                                                               tail_part_number/*start_from_part*/ );
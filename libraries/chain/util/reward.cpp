@@ -2,9 +2,21 @@
 #include <hive/chain/util/reward.hpp>
 #include <hive/chain/util/uint256.hpp>
 
+#include <algorithm>
+#include <future>
+#include <thread>
+
 namespace hive { namespace chain { namespace util {
 
+// below that many rshares it is not worth starting threads to evaluate the curve
+#define MIN_REWARD_CURVE_BATCH_PER_THREAD 1024
+
 uint64_t get_rshare_reward( const comment_reward_context& ctx )
+{
+  return get_rshare_reward( ctx, evaluate_reward_curve( ctx.rshares.value, ctx.reward_curve, ctx.content_constant ) );
+}
+
+uint64_t get_rshare_reward( const comment_reward_context& ctx, const uint128_t& reward_curve_claim )
 {
   try
   {
@@ -16,7 +28,7 @@ uint64_t get_rshare_reward( const comment_reward_context& ctx )
 
   //idump( (ctx) );
 
-  u256 claim = to256( evaluate_reward_curve( ctx.rshares.value, ctx.reward_curve, ctx.content_constant ) );
+  u256 claim = to256( reward_curve_claim );
   claim = ( claim * ctx.reward_weight ) / HIVE_100_PERCENT;
 
   u256 payout_u256 = ( rf * claim ) / total_claims;
@@ -77,4 +89,33 @@ uint128_t evaluate_reward_curve( const uint128_t& rshares, const protocol::curve
   return result;
 }
 
+std::vector< uint128_t > evaluate_reward_curve( const std::vector< share_type >& rshares, const protocol::curve_id& curve, const uint128_t& var1 )
+{
+  std::vector< uint128_t > result( rshares.size() );
+  auto evaluate_range = [&]( size_t begin, size_t end )
+  {
+    for( size_t i = begin; i < end; ++i )
+      result[i] = evaluate_reward_curve( rshares[i].value, curve, var1 );
+  };
+
+  const size_t thread_count = std::min< size_t >( std::max( std::thread::hardware_concurrency(), 1u ),
+    rshares.size() / MIN_REWARD_CURVE_BATCH_PER_THREAD );
+  if( thread_count <= 1 )
+  {
+    evaluate_range( 0, rshares.size() );
+    return result;
+  }
+
+  // each thread fills its own part of the result, the calling thread takes the last one
+  const size_t chunk_size = ( rshares.size() + thread_count - 1 ) / thread_count;
+  std::vector< std::future< void > > chunks;
+  for( size_t begin = 0; begin + chunk_size < rshares.size(); begin += chunk_size )
+    chunks.push_back( std::async( std::launch::async, evaluate_range, begin, begin + chunk_size ) );
+  evaluate_range( chunks.size() * chunk_size, rshares.size() );
+  for( auto& chunk : chunks )
+    chunk.get();
+
+  return result;
+}
+
 } } } // hive::chain::util
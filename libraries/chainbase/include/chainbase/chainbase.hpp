@@ -279,6 +279,38 @@ namespace chainbase {
     uint32_t _lock_serial_number; // allows us to associate the "locking" log with the "releasing" log
   };
 
+  /**
+    * Measures how long a read lock is held. When a writer was left waiting behind the reader for longer than
+    * the threshold, the reader is reported, so API calls that stall block processing can be identified.
+    */
+  class read_lock_hold_monitor
+  {
+  public:
+    read_lock_hold_monitor(const std::atomic<int32_t>& pending_write_lock_requests, const char* reader_description, uint32_t lock_serial_number) :
+      _pending_write_lock_requests(pending_write_lock_requests),
+      _lock_acquired(fc::time_point::now()),
+      _reader_description(reader_description),
+      _lock_serial_number(lock_serial_number)
+    {}
+    ~read_lock_hold_monitor()
+    {
+      if (_pending_write_lock_requests.load(std::memory_order_relaxed) <= 0)
+        return;
+      fc::microseconds hold_duration = fc::time_point::now() - _lock_acquired;
+      if (hold_duration.count() > warning_threshold_us)
+        fc_wlog(fc::logger::get("chainlock"), "${reader} held chainbase read lock for ${held}µs while writer was waiting (#${_lock_serial_number})",
+                ("reader", _reader_description ? _reader_description : "unnamed reader")("held", hold_duration.count())(_lock_serial_number));
+    }
+
+    static constexpr int64_t warning_threshold_us = 50000;
+
+  private:
+    const std::atomic<int32_t>& _pending_write_lock_requests;
+    fc::time_point _lock_acquired;
+    const char* const _reader_description;
+    uint32_t _lock_serial_number;
+  };
+
   class index_extension
   {
   public:
@@ -342,23 +374,27 @@ namespace chainbase {
       typedef typename value_type::id_type                          id_type;
       typedef allocator< generic_index >                            allocator_type;
 
+      /**
+        * Undo data of single session. Objects created during session are not stored anywhere - since ids are
+        * assigned sequentially, they are exactly those with id in range [old_next_id, _next_id) that still exist
+        * (the range of squashed sessions is also contiguous). Only copies of modified and removed objects that
+        * existed before the session are kept.
+        */
       struct undo_state
       {
         typedef undo_allocator_carrier< std::pair<const id_type, value_type> > id_value_allocator_type;
-        typedef undo_allocator_carrier< id_type >                              id_allocator_type;
 
         undo_state( generic_index& index )
         : old_values( id_value_allocator_type( index._shared_undo_object_allocator ) ),
-          removed_values( id_value_allocator_type( index._shared_undo_object_allocator ) ),
-          new_ids( id_allocator_type( index._shared_undo_id_allocator ) )
+          removed_values( id_value_allocator_type( index._shared_undo_object_allocator ) )
         {}
 
         typedef t_map< id_type, value_type, std::less<id_type>, id_value_allocator_type > id_value_type_map;
-        typedef t_set< id_type, std::less<id_type>, id_allocator_type >                   id_type_set;
+
+        bool is_new( const id_type& id ) const { return !( id < old_next_id ); }
 
         id_value_type_map            old_values;
         id_value_type_map            removed_values;
-        id_type_set                  new_ids;
         id_type                      old_next_id = id_type( 0 );
         int64_t                      revision = 0;
       };
@@ -367,7 +403,6 @@ namespace chainbase {
       generic_index( const Allocator& a, bfs::path p )
       : _stack( get_allocator_helper_t<value_type>::get_generic_allocator(a) ),
         _shared_undo_object_allocator( a ),
-        _shared_undo_id_allocator( a ),
         _indices( a, p ),
         _size_of_value_type( sizeof(value_type) ),
         _size_of_this(sizeof(*this)) {}
@@ -376,7 +411,6 @@ namespace chainbase {
       generic_index( const Allocator& a )
       : _stack( get_allocator_helper_t<value_type>::get_generic_allocator(a) ),
         _shared_undo_object_allocator( a ),
-        _shared_undo_id_allocator( a ),
         _indices( a ),
         _size_of_value_type( sizeof(value_type) ),
         _size_of_this(sizeof(*this)) {}
@@ -647,15 +681,12 @@ namespace chainbase {
             _item_additional_allocation += new_size - old_size;
         }
 
-        for( const auto& id : head.new_ids )
+        for( id_type id = head.old_next_id; id < _next_id; ++id )
         {
           auto position = _indices.find(id);
 
           if(position == _indices.end())
-          {
-            CHAINBASE_THROW_EXCEPTION(std::logic_error("unable to find object with id: " +
-              std::to_string(id) + "in the index holding types: " + get_type_name()));
-          }
+            continue; // object was created and then removed within the session
 
           size_t size = 0;
           if constexpr( value_type::has_dynamic_alloc_t::value )
@@ -684,7 +715,6 @@ namespace chainbase {
         if( keep_alive )
         {
           head.old_values.clear();
-          head.new_ids.clear();
           head.removed_values.clear();
           //head.old_next_id stays the same
           //head.revision and _revision stay the same
@@ -712,7 +742,6 @@ namespace chainbase {
           {
             auto& head = _stack.back();
             head.old_values.clear();
-            head.new_ids.clear();
             head.removed_values.clear();
             head.old_next_id = _next_id;
             ++_revision;
@@ -729,7 +758,7 @@ namespace chainbase {
         auto& prev_state = _stack[_stack.size()-2];
 
         // An object's relationship to a state can be:
-        // in new_ids            : new
+        // id >= old_next_id     : new
         // in old_values (was=X) : upd(was=X)
         // in removed (was=X)    : del(was=X)
         // not in any of above   : nop
@@ -768,57 +797,56 @@ namespace chainbase {
         // (a serious logic error which should never happen).
         //
 
-        // We can only be outside type A/AB (the nop path) if B is not nop, so it suffices to iterate through B's three containers.
+        // We can only be outside type A/AB (the nop path) if B is not nop, so it suffices to iterate through B's containers.
+
+        // *+new, but we assume the N/A cases don't happen, leaving type B nop+new -> new; new ids of B directly follow
+        // new ids of A, so the merged range [prev_state.old_next_id, _next_id) needs no work
 
         for( auto& item : state.old_values )
         {
-          if( prev_state.new_ids.find( item.second.get_id() ) != prev_state.new_ids.end() )
+          if( prev_state.is_new( item.first ) )
           {
             // new+upd -> new, type A
             continue;
           }
-          if( prev_state.old_values.find( item.second.get_id() ) != prev_state.old_values.end() )
+          auto old_hint = prev_state.old_values.lower_bound( item.first );
+          if( old_hint != prev_state.old_values.end() && old_hint->first == item.first )
           {
             // upd(was=X) + upd(was=Y) -> upd(was=X), type A
             continue;
           }
           // del+upd -> N/A
-          assert( prev_state.removed_values.find( item.second.get_id() ) == prev_state.removed_values.end() );
+          assert( prev_state.removed_values.find( item.first ) == prev_state.removed_values.end() );
           // nop+upd(was=Y) -> upd(was=Y), type B
-          prev_state.old_values.emplace( std::move(item) );
+          prev_state.old_values.emplace_hint( old_hint, std::move(item) );
         }
 
-        // *+new, but we assume the N/A cases don't happen, leaving type B nop+new -> new
-        for( const auto& id : state.new_ids )
-          prev_state.new_ids.insert(id);
-
         // *+del
         for( auto& obj : state.removed_values )
         {
-          if( prev_state.new_ids.find( obj.second.get_id() ) != prev_state.new_ids.end() )
+          if( prev_state.is_new( obj.first ) )
           {
             // new + del -> nop (type C)
-            prev_state.new_ids.erase( obj.second.get_id() );
             continue;
           }
-          auto it = prev_state.old_values.find( obj.second.get_id() );
+          auto removed_hint = prev_state.removed_values.lower_bound( obj.first );
+          auto it = prev_state.old_values.find( obj.first );
           if( it != prev_state.old_values.end() )
           {
             // upd(was=X) + del(was=Y) -> del(was=X)
-            prev_state.removed_values.emplace( std::move(*it) );
-            prev_state.old_values.erase( obj.second.get_id() );
+            prev_state.removed_values.emplace_hint( removed_hint, std::move(*it) );
+            prev_state.old_values.erase( it );
             continue;
           }
           // del + del -> N/A
-          assert( prev_state.removed_values.find( obj.second.get_id() ) == prev_state.removed_values.end() );
+          assert( removed_hint == prev_state.removed_values.end() || removed_hint->first != obj.first );
           // nop + del(was=Y) -> del(was=Y)
-          prev_state.removed_values.emplace( std::move(obj) ); //[obj.second->get_id()] = std::move(obj.second);
+          prev_state.removed_values.emplace_hint( removed_hint, std::move(obj) );
         }
 
         if( keep_alive )
         {
           state.old_values.clear();
-          state.new_ids.clear();
           state.removed_values.clear();
           state.old_next_id = _next_id;
           //head.revision and _revision stay the same
@@ -869,14 +897,15 @@ namespace chainbase {
 
         auto& head = _stack.back();
 
-        if( head.new_ids.find( v.get_id() ) != head.new_ids.end() )
+        if( head.is_new( v.get_id() ) )
           return;
 
-        auto itr = head.old_values.find( v.get_id() );
-        if( itr != head.old_values.end() )
+        // single tree walk for both lookup and insertion
+        auto itr = head.old_values.lower_bound( v.get_id() );
+        if( itr != head.old_values.end() && itr->first == v.get_id() )
           return;
 
-        head.old_values.emplace( v.get_id(), v.copy_chain_object() );
+        head.old_values.emplace_hint( itr, v.get_id(), v.copy_chain_object() );
       }
 
       void on_remove( const value_type& v )
@@ -884,38 +913,32 @@ namespace chainbase {
         if( !enabled() ) return;
 
         auto& head = _stack.back();
-        if( head.new_ids.count( v.get_id() ) )
-        {
-          head.new_ids.erase( v.get_id() );
-          return;
-        }
+        if( head.is_new( v.get_id() ) )
+          return; // object vanishes from [old_next_id, _next_id) range on its own
 
         auto itr = head.old_values.find( v.get_id() );
         if( itr != head.old_values.end() )
         {
           head.removed_values.emplace( std::move( *itr ) );
-          head.old_values.erase( v.get_id() );
+          head.old_values.erase( itr );
           return;
         }
 
-        if( head.removed_values.count( v.get_id() ) )
+        auto removed_itr = head.removed_values.lower_bound( v.get_id() );
+        if( removed_itr != head.removed_values.end() && removed_itr->first == v.get_id() )
           return;
 
-        head.removed_values.emplace( v.get_id(), v.copy_chain_object() );
+        head.removed_values.emplace_hint( removed_itr, v.get_id(), v.copy_chain_object() );
       }
 
       void on_create( const value_type& v )
       {
-        if( !enabled() ) return;
-        auto& head = _stack.back();
-
-        head.new_ids.insert( v.get_id() );
+        // nothing to record - see undo_state
       }
 
       t_deque< undo_state > _stack;
-      // Shared allocators used as 'impl' in all undo_state layers
+      // Shared allocator used as 'impl' in all undo_state layers
       undo_state_allocator<typename undo_state::id_value_type_map::stored_allocator_type::value_type> _shared_undo_object_allocator;
-      undo_state_allocator<typename undo_state::id_type_set::stored_allocator_type::value_type> _shared_undo_id_allocator;
 
       /**
         *  Each new session increments the revision, a squash will decrement the revision by combining
@@ -1328,7 +1351,7 @@ namespace chainbase {
       }
 
       template< typename Lambda >
-      auto with_read_lock( Lambda&& callback, fc::microseconds wait_for_microseconds = fc::microseconds() ) -> decltype( (*(Lambda*)nullptr)() )
+      auto with_read_lock( Lambda&& callback, fc::microseconds wait_for_microseconds = fc::microseconds(), const char* reader_description = nullptr ) -> decltype( (*(Lambda*)nullptr)() )
       {
         uint32_t lock_serial_number = _next_read_lock_serial_number.fetch_add(1, std::memory_order_relaxed);
         fc_dlog(fc::logger::get("chainlock"), "trying to get chainbase_read_lock: read_lock_count=${_read_lock_count} write_lock_count=${_write_lock_count} (#${lock_serial_number})", 
@@ -1357,6 +1380,8 @@ namespace chainbase {
                 ("_read_lock_count", _read_lock_count.load(std::memory_order_relaxed))
                 (lock_serial_number));
 
+        BOOST_ATTRIBUTE_UNUSED
+        read_lock_hold_monitor monitor(_pending_write_lock_requests, reader_description, lock_serial_number);
         return callback();
       }
 
@@ -1374,7 +1399,9 @@ namespace chainbase {
         int_incrementer ii(_write_lock_count, "write", lock_serial_number);
 #endif
 
+        _pending_write_lock_requests.fetch_add(1, std::memory_order_relaxed);
         lock.lock();
+        _pending_write_lock_requests.fetch_sub(1, std::memory_order_relaxed);
         fc_dlog(fc::logger::get("chainlock"),"got chainbase_write_lock: read_lock_count=${_read_lock_count} write_lock_count=${_write_lock_count} (#${lock_serial_number})",
                 ("_read_lock_count", _read_lock_count.load(std::memory_order_relaxed))
                 ("_write_lock_count", _write_lock_count.load(std::memory_order_relaxed))
@@ -1482,6 +1509,7 @@ namespace chainbase {
       std::atomic<int32_t>                                        _write_lock_count = {0};
       std::atomic<uint32_t>                                       _next_read_lock_serial_number = {0};
       std::atomic<uint32_t>                                       _next_write_lock_serial_number = {0};
+      std::atomic<int32_t>                                        _pending_write_lock_requests = {0};
       bool                                                        _enable_require_locking = false;
 
       bool                                                        _is_open = false;
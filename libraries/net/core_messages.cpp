@@ -32,6 +32,7 @@ namespace graphene { namespace net {
   const core_message_type_enum trx_message::type                             = core_message_type_enum::trx_message_type;
   const core_message_type_enum block_message::type                           = core_message_type_enum::block_message_type;
   const core_message_type_enum compressed_block_message::type                = core_message_type_enum::compressed_block_message_type;
+  const core_message_type_enum compact_block_message::type                   = core_message_type_enum::compact_block_message_type;
   const core_message_type_enum item_ids_inventory_message::type              = core_message_type_enum::item_ids_inventory_message_type;
   const core_message_type_enum blockchain_item_ids_inventory_message::type   = core_message_type_enum::blockchain_item_ids_inventory_message_type;
   const core_message_type_enum fetch_blockchain_item_ids_message::type       = core_message_type_enum::fetch_blockchain_item_ids_message_type;
@@ -50,6 +51,67 @@ namespace graphene { namespace net {
   const core_message_type_enum get_current_connections_request_message::type = core_message_type_enum::get_current_connections_request_message_type;
   const core_message_type_enum get_current_connections_reply_message::type   = core_message_type_enum::get_current_connections_reply_message_type;
 
+  compact_block_message::compact_block_message(const std::shared_ptr<full_block_type>& full_block,
+                                               const std::function<bool(const full_transaction_type&)>& peer_has_transaction) :
+    header(full_block->get_block_header())
+  {
+    const std::vector<std::shared_ptr<full_transaction_type>>& full_transactions = full_block->get_full_transactions();
+    short_transaction_ids.reserve(full_transactions.size());
+    for (uint32_t i = 0; i < full_transactions.size(); ++i)
+    {
+      const full_transaction_type& full_transaction = *full_transactions[i];
+      if (peer_has_transaction(full_transaction))
+        short_transaction_ids.push_back(get_short_transaction_id(full_transaction.get_merkle_digest()));
+      else
+      {
+        const hive::chain::serialized_transaction_data& serialized_transaction = full_transaction.get_serialized_transaction();
+        prefilled_transactions.push_back(prefilled_transaction{i, std::vector<char>(serialized_transaction.begin, serialized_transaction.signed_transaction_end)});
+      }
+    }
+  }
+
+  /* static */ uint64_t compact_block_message::get_short_transaction_id(const hive::protocol::digest_type& merkle_digest)
+  {
+    // leading bytes of the digest, so the transaction cache (ordered by digest) can look it up as a prefix
+    uint64_t short_id;
+    memcpy(&short_id, merkle_digest.data(), sizeof(short_id));
+    return short_id;
+  }
+
+  std::shared_ptr<full_block_type> compact_block_message::rebuild_block(uint32_t& missing_transaction_count) const
+  {
+    const size_t transaction_count = short_transaction_ids.size() + prefilled_transactions.size();
+    std::vector<std::shared_ptr<full_transaction_type>> full_transactions(transaction_count);
+
+    for (const prefilled_transaction& prefilled : prefilled_transactions)
+    {
+      FC_ASSERT(prefilled.index < transaction_count && !full_transactions[prefilled.index],
+                "Invalid prefilled transaction index ${index} in compact block", ("index", prefilled.index));
+      full_transactions[prefilled.index] = full_transaction_type::create_from_serialized_transaction(prefilled.serialized_transaction.data(),
+                                                                                                     prefilled.serialized_transaction.size(),
+                                                                                                     true /* cache this transaction */);
+    }
+
+    missing_transaction_count = 0;
+    auto short_id_iter = short_transaction_ids.begin();
+    for (std::shared_ptr<full_transaction_type>& full_transaction : full_transactions)
+      if (!full_transaction)
+      {
+        full_transaction = hive::chain::full_transaction_cache::get_instance().find_by_merkle_digest_prefix(*short_id_iter++);
+        if (!full_transaction)
+          ++missing_transaction_count;
+      }
+
+    if (missing_transaction_count != 0)
+      return std::shared_ptr<full_block_type>();
+
+    std::shared_ptr<full_block_type> full_block = full_block_type::create_from_signed_block_header_and_transactions(header, full_transactions);
+    // merkle root is recomputed from the transactions we found, it only matches if all of them are the right ones
+    if (full_block->get_block_header().transaction_merkle_root != header.transaction_merkle_root)
+      return std::shared_ptr<full_block_type>();
+    return full_block;
+  }
+
   message::message(const block_message& msg)
   {
     assert(msg.full_block);
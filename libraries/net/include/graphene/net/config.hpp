@@ -23,7 +23,8 @@
  */
 #pragma once
 
-#define GRAPHENE_NET_PROTOCOL_VERSION                              107
+#define GRAPHENE_NET_PROTOCOL_VERSION                              108
+#define GRAPHENE_NET_PROTOCOL_COMPACT_BLOCKS_VERSION               108 // support for compact blocks added in 108
 #define GRAPHENE_NET_PROTOCOL_COMPRESSED_BLOCKS_VERSION            107 // support for compressed blocks added in 107
 #define GRAPHENE_NET_PROTOCOL_ADVERTISE_BLOCKS_BY_BLOCK_ID_VERSION 107 // share blocks by block_id instead of by block_message hash added in 107
 #define GRAPHENE_NET_PROTOCOL_FIREWALL_CHECK_VERSION               106 // support for the firewall check was added in 106
@@ -50,6 +51,12 @@
 
 #define GRAPHENE_NET_PEER_HANDSHAKE_INACTIVITY_TIMEOUT       5
 
+/**
+ * Blocks older than this (in seconds) are never sent as compact blocks, peers asking for them
+ * are most likely syncing and won't have their transactions
+ */
+#define GRAPHENE_NET_MAX_COMPACT_BLOCK_AGE                   60
+
 #define GRAPHENE_NET_PEER_DISCONNECT_TIMEOUT                 20
 
 #define GRAPHENE_NET_TEST_SEED_IP                            "104.236.44.210" // autogenerated
@@ -60,6 +67,17 @@
 
 #define GRAPHENE_NET_MAXIMUM_QUEUED_MESSAGES_IN_BYTES        (1024 * 1024)
 
+/**
+ * stcp_socket encrypts and decrypts up to this many bytes per socket call.
+ * Chunks of at least GRAPHENE_NET_STCP_CRYPTO_OFFLOAD_THRESHOLD bytes are
+ * handed to one of the node's crypto threads (GRAPHENE_NET_DEFAULT_STCP_CRYPTO_THREADS
+ * unless configured otherwise) so the p2p thread can service other peers in the
+ * meantime; smaller ones are cheaper to process inline than to hand off.
+ */
+#define GRAPHENE_NET_STCP_BUFFER_SIZE                        (64 * 1024)
+#define GRAPHENE_NET_STCP_CRYPTO_OFFLOAD_THRESHOLD           4096
+#define GRAPHENE_NET_DEFAULT_STCP_CRYPTO_THREADS             2
+
 /**
  * When we receive a message from the network, we advertise it to
  * our peers and save a copy in a cache were we will find it if
@@ -86,6 +104,22 @@
 
 #define GRAPHENE_NET_MAX_BLOCKS_PER_PEER_DURING_SYNCING      200
 
+/**
+ * During syncing, each idle peer is handed a stripe of blocks sized in
+ * proportion to its measured download rate relative to the fastest peer.
+ * Slow peers still get at least this many blocks per request.
+ */
+#define GRAPHENE_NET_MIN_BLOCKS_PER_PEER_DURING_SYNCING      20
+
+/**
+ * A peer whose current batch of sync blocks is arriving this many times
+ * slower than the best rate of another syncing peer (and has been pending
+ * for at least GRAPHENE_NET_SYNC_STRAGGLER_MIN_SECONDS) is considered a
+ * straggler; its outstanding blocks are re-striped across the other peers.
+ */
+#define GRAPHENE_NET_SYNC_STRAGGLER_FACTOR                   4
+#define GRAPHENE_NET_SYNC_STRAGGLER_MIN_SECONDS              3
+
 /**
  * During normal operation, how many items will be fetched from each
  * peer at a time.  This will only come into play when the network
@@ -38,6 +38,7 @@
 #include <fc/exception/exception.hpp>
 #include <fc/io/enum_type.hpp>
 
+#include <functional>
 #include <vector>
 
 namespace graphene { namespace net {
@@ -72,6 +73,7 @@ namespace graphene { namespace net {
     trx_message_type                             = 1000,
     block_message_type                           = 1001,
     compressed_block_message_type                = 1002,
+    compact_block_message_type                   = 1003,
     core_message_type_first                      = 5000,
     item_ids_inventory_message_type              = 5001,
     blockchain_item_ids_inventory_message_type   = 5002,
@@ -145,6 +147,38 @@ namespace graphene { namespace net {
     std::shared_ptr<full_block_type> full_block;
   };
 
+  // a block sent as its signed header plus short ids of the transactions the receiving node
+  // most likely already has in its transaction cache.  Only transactions the sender doesn't think
+  // the peer has seen are sent in full.  Like compressed_block_message, this is never advertised
+  // or requested directly: a source node sends it in place of a recent block requested as type 1001
+  // if the sink supports it.  If the sink can't rebuild the block (missing transactions, short id
+  // collision), it requests the block again as type 1002, which is always answered with a full block.
+  struct prefilled_transaction
+  {
+    uint32_t          index = 0; // position of the transaction in the block
+    std::vector<char> serialized_transaction;
+  };
+
+  struct compact_block_message
+  {
+    static const core_message_type_enum type;
+
+    hive::protocol::signed_block_header header;
+    std::vector<uint64_t>               short_transaction_ids; // for all transactions that are not prefilled, in block order
+    std::vector<prefilled_transaction>  prefilled_transactions;
+
+    compact_block_message(){}
+    compact_block_message(const std::shared_ptr<full_block_type>& full_block,
+                          const std::function<bool(const full_transaction_type&)>& peer_has_transaction);
+
+    static uint64_t get_short_transaction_id(const hive::protocol::digest_type& merkle_digest);
+
+    /// rebuilds the block from prefilled transactions and the ones found in full_transaction_cache;
+    /// empty result when some transaction is missing (counted in missing_transaction_count) or the ones
+    /// found don't give the merkle root from the header (short id collision); throws on malformed message
+    std::shared_ptr<full_block_type> rebuild_block(uint32_t& missing_transaction_count) const;
+  };
+
   struct item_ids_inventory_message
   {
     static const core_message_type_enum type;
@@ -433,6 +467,7 @@ FC_REFLECT_ENUM( graphene::net::core_message_type_enum,
                  (trx_message_type)
                  (block_message_type)
                  (compressed_block_message_type)
+                 (compact_block_message_type)
                  (core_message_type_first)
                  (item_ids_inventory_message_type)
                  (blockchain_item_ids_inventory_message_type)
@@ -457,6 +492,9 @@ FC_REFLECT_ENUM( graphene::net::core_message_type_enum,
 //FC_REFLECT( graphene::net::block_message, (full_block)(block_id) )  // explicit serialization
 //FC_REFLECT( graphene::net::compressed_block_message, (full_block)(block_id) )  // explicit serialization
 
+FC_REFLECT( graphene::net::prefilled_transaction, (index)(serialized_transaction) )
+FC_REFLECT( graphene::net::compact_block_message, (header)(short_transaction_ids)(prefilled_transactions) )
+
 FC_REFLECT( graphene::net::item_id, (item_type)(item_hash) )
 FC_REFLECT( graphene::net::item_ids_inventory_message, (item_type)(item_hashes_available) )
 FC_REFLECT( graphene::net::blockchain_item_ids_inventory_message, (total_remaining_item_count)
@@ -25,6 +25,8 @@
 #include <fc/network/tcp_socket.hpp>
 #include <graphene/net/message.hpp>
 
+namespace fc { class thread; }
+
 namespace graphene { namespace net {
 
   namespace detail { class message_oriented_connection_impl; }
@@ -46,6 +48,7 @@ namespace graphene { namespace net {
        message_oriented_connection(message_oriented_connection_delegate* delegate = nullptr);
        ~message_oriented_connection();
        fc::tcp_socket& get_socket();
+       void set_crypto_thread(fc::thread* crypto_thread);
 
        void accept();
        void bind(const fc::ip::endpoint& local_endpoint);
@@ -38,6 +38,8 @@ struct node_configuration
    uint32_t maximum_number_of_sync_blocks_to_prefetch = GRAPHENE_NET_MAX_NUMBER_OF_BLOCKS_TO_PREFETCH;
    uint32_t maximum_blocks_per_peer_during_syncing = GRAPHENE_NET_MAX_BLOCKS_PER_PEER_DURING_SYNCING;
    int64_t active_ignored_request_timeout_microseconds = 6000000;
+   /** number of threads encrypting and decrypting peer traffic, 0 to do it on the p2p thread; read once when node starts */
+   uint32_t stcp_crypto_threads = GRAPHENE_NET_DEFAULT_STCP_CRYPTO_THREADS;
 };
 
 } }
@@ -56,4 +58,5 @@ FC_REFLECT(graphene::net::node_configuration,
    (maximum_number_of_sync_blocks_to_prefetch)
    (maximum_blocks_per_peer_during_syncing)
    (active_ignored_request_timeout_microseconds)
+   (stcp_crypto_threads)
 )
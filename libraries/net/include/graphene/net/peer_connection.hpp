@@ -69,6 +69,8 @@ namespace graphene { namespace net
                               const message& received_message) = 0;
       virtual void on_connection_closed(peer_connection* originating_peer) = 0;
       virtual std::shared_ptr<full_block_type> get_full_block_by_block_id(const block_id_type& block_id) = 0;
+      /// thread for the cipher work of a new connection, nullptr to do it on the calling thread
+      virtual fc::thread* get_next_stcp_crypto_thread() = 0;
     };
 
     class peer_connection;
@@ -156,9 +158,11 @@ namespace graphene { namespace net
       struct virtual_queued_block_message : queued_message
       {
         std::shared_ptr<full_block_type> full_block;
+        bool allow_compact_block = false;
 
-        virtual_queued_block_message(const std::shared_ptr<full_block_type>& full_block) :
-          full_block(full_block)
+        virtual_queued_block_message(const std::shared_ptr<full_block_type>& full_block, bool allow_compact_block = false) :
+          full_block(full_block),
+          allow_compact_block(allow_compact_block)
         {}
 
         message get_message(peer_connection_delegate* node, peer_connection* peer) override;
@@ -232,11 +236,16 @@ namespace graphene { namespace net
       fc::optional<boost::tuple<std::vector<item_hash_t>, fc::time_point> > item_ids_requested_from_peer; /// we check this to detect a timed-out request and in busy()
       fc::time_point last_sync_item_received_time; /// the time we received the last sync item or the time we sent the last batch of sync item requests to this peer
       std::set<item_hash_t> sync_items_requested_from_peer; /// ids of blocks we've requested from this peer during sync.  fetch from another peer if this peer disconnects
+      std::map<item_hash_t, fc::time_point> sync_items_restriped_from_peer; /// ids of blocks requested from this peer that we since released to faster peers (and when), still accepted if they arrive
+      fc::time_point sync_batch_requested_time; /// when we sent the current batch of sync item requests to this peer
+      uint32_t sync_batch_size = 0; /// number of blocks in the current batch of sync item requests (0 once measured)
+      double sync_blocks_per_second = 0; /// moving average of sync block download rate of this peer, 0 until the first batch completes
       item_hash_t last_block_delegate_has_seen; /// the hash of the last block  this peer has told us about that the peer knows
       fc::time_point_sec last_block_time_delegate_has_seen;
       bool inhibit_fetching_sync_blocks = false;
       /// @}
       void reset_id_search_for_peer() { last_requested_block_number_for_peers_on_this_fork = first_id_block_number - 1; }
+      void update_sync_throughput(uint32_t blocks_received, const fc::time_point& now);
       /// latency timing data
       std::unordered_map< item_hash_t, fc::time_point > pending_item_request_times;
       /// @}
@@ -264,6 +273,7 @@ namespace graphene { namespace net
       item_to_time_map_type items_requested_from_peer;  /// items we've requested from this peer during normal operation.  fetch from another peer if this peer disconnects
       uint32_t compressed_blocks_received_from_peer = 0;   // fields to track which peers are sending us compressed vs uncompressed blocks
       uint32_t uncompressed_blocks_received_from_peer = 0;
+      uint32_t compact_blocks_received_from_peer = 0;
       /// @}
 
       // if they're flooding us with transactions, we set this to avoid fetching for a few seconds to let the
@@ -296,7 +306,7 @@ namespace graphene { namespace net
       void on_connection_closed(message_oriented_connection* originating_connection) override;
 
       void send_queueable_message(std::unique_ptr<queued_message>&& message_to_send);
-      void send_block_message(const std::shared_ptr<full_block_type>& full_block);
+      void send_block_message(const std::shared_ptr<full_block_type>& full_block, bool allow_compact_block = false);
       void send_message(const message& message_to_send, size_t message_send_time_field_offset = (size_t)-1);
       void send_item(const item_id& item_to_send);
       void close_connection();
@@ -326,6 +336,9 @@ namespace graphene { namespace net
       fc::optional<fc::ip::endpoint> get_endpoint_for_db() const;
 
       bool supports_compressed_blocks() const;
+      bool supports_compact_blocks() const;
+      /// true if the transaction went through our inventory exchange with this peer in either direction
+      bool has_seen_transaction(const full_transaction_type& full_transaction) const;
       bool advertise_blocks_by_block_id() const;
       bool requires_alternate_compression_for_block(const std::shared_ptr<full_block_type>& full_block) const;
     private:
@@ -26,6 +26,8 @@
 #include <fc/crypto/aes.hpp>
 #include <fc/crypto/elliptic.hpp>
 
+namespace fc { class thread; }
+
 namespace graphene { namespace net {
 
 /**
@@ -56,18 +58,28 @@ class stcp_socket : public virtual fc::iostream
     using istream::get;
     void             get( char& c ) { read( &c, 1 ); }
     fc::sha512       get_shared_secret() const { return _shared_secret; }
+    /// thread to run cipher work of this socket on, nullptr to run it inline; the thread has to outlive all reads and writes
+    void             set_crypto_thread( fc::thread* crypto_thread ) { _crypto_thread = crypto_thread; }
   private:
     void do_key_exchange();
+    bool should_offload_cipher(size_t len) const;
+    template<typename Functor>
+    uint32_t run_cipher_on_crypto_thread(Functor&& cipher_operation);
 
     fc::sha512           _shared_secret;
     fc::ecc::private_key _priv_key;
     fc::array<char,8>    _buf;
     //uint32_t             _buf_len;
     fc::tcp_socket       _sock;
-    fc::aes_encoder      _send_aes;
-    fc::aes_decoder      _recv_aes;
+    /// cipher contexts and buffers are shared with cipher jobs on the crypto thread, so a job can outlive a canceled caller
+    std::shared_ptr<fc::aes_encoder> _send_aes;
+    std::shared_ptr<fc::aes_decoder> _recv_aes;
+    fc::thread*          _crypto_thread; /// all cipher work of this socket runs here (or inline), keeping each stream in order
+    bool                 _cipher_job_abandoned; /// a canceled caller left its cipher job running, cipher streams are out of sync
     std::shared_ptr<char> _read_buffer;
     std::shared_ptr<char> _write_buffer;
+    std::shared_ptr<char> _decrypted_buffer; /// output of offloaded decryption, copied to the caller once done
+    std::shared_ptr<char> _plaintext_buffer; /// copy of the caller's data for offloaded encryption
 #ifndef NDEBUG
     bool _read_buffer_in_use;
     bool _write_buffer_in_use;
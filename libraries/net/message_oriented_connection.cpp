@@ -72,6 +72,7 @@ namespace graphene { namespace net {
       void start_read_loop();
     public:
       fc::tcp_socket& get_socket();
+      void set_crypto_thread(fc::thread* crypto_thread);
       void accept();
       void connect_to(const fc::ip::endpoint& remote_endpoint);
       void bind(const fc::ip::endpoint& local_endpoint);
@@ -117,6 +118,12 @@ namespace graphene { namespace net {
       return _sock.get_socket();
     }
 
+    void message_oriented_connection_impl::set_crypto_thread(fc::thread* crypto_thread)
+    {
+      VERIFY_CORRECT_THREAD();
+      _sock.set_crypto_thread(crypto_thread);
+    }
+
     void message_oriented_connection_impl::accept()
     {
       VERIFY_CORRECT_THREAD();
@@ -366,6 +373,11 @@ namespace graphene { namespace net {
     return my->get_socket();
   }
 
+  void message_oriented_connection::set_crypto_thread(fc::thread* crypto_thread)
+  {
+    my->set_crypto_thread(crypto_thread);
+  }
+
   void message_oriented_connection::accept()
   {
     my->accept();
@@ -441,6 +441,11 @@ namespace graphene { namespace net {
       fc::path             _node_configuration_directory;
       node_configuration   _node_configuration;
 
+      /// threads shared by all peer connections for encrypting and decrypting their traffic,
+      /// so that with many peers the p2p thread isn't bound by it; sockets are assigned round-robin
+      std::vector<std::unique_ptr<fc::thread>> _stcp_crypto_threads;
+      uint32_t             _next_stcp_crypto_thread = 0;
+
       /// stores the endpoint we're listening on.  This will be the same as
       // _node_configuration.listen_endpoint, unless that endpoint was already
       // in use.
@@ -622,6 +627,11 @@ namespace graphene { namespace net {
       void request_sync_item_from_peer( const peer_connection_ptr& peer, const item_hash_t& item_to_request );
       void request_sync_items_from_peer( const peer_connection_ptr& peer, const std::vector<item_hash_t>& items_to_request );
       void update_last_requested_block_number_for_peers_on_this_fork(uint32_t last_requested_block_number, const item_hash_t& last_requested_block_id);
+      uint32_t get_sync_stripe_size_for_peer(const peer_connection_ptr& peer, double fastest_sync_blocks_per_second) const;
+      bool restripe_sync_requests_from_slow_peers();
+      bool is_duplicate_sync_item(const std::shared_ptr<full_block_type>& full_block);
+      bool is_sync_item_available_from_other_peer(const peer_connection_ptr& peer, const item_hash_t& item_hash, uint32_t block_num) const;
+      size_t count_outstanding_restriped_sync_items(const peer_connection_ptr& peer, const fc::time_point& prune_threshold);
       void fetch_sync_items_loop();
       void trigger_fetch_sync_items_loop();
 
@@ -721,6 +731,7 @@ namespace graphene { namespace net {
       void process_block_during_sync(peer_connection* originating_peer, const std::shared_ptr<full_block_type>& full_block);
       void process_block_during_normal_operation(peer_connection* originating_peer, const std::shared_ptr<full_block_type>& full_block);
       void process_block_message(peer_connection* originating_peer, const message& message_to_process, const message_hash_type& message_hash);
+      std::shared_ptr<full_block_type> reconstruct_compact_block(peer_connection* originating_peer, const compact_block_message& compact_block, const block_id_type& block_id);
       void process_trx_message(peer_connection* originating_peer, const trx_message& transaction_message_to_process);
 
       void process_ordinary_message(peer_connection* originating_peer, const message& message_to_process, const message_hash_type& message_hash);
@@ -790,6 +801,9 @@ namespace graphene { namespace net {
       void                       set_total_bandwidth_limit( uint32_t upload_bytes_per_second, uint32_t download_bytes_per_second );
       fc::variant_object         get_call_statistics() const;
       std::shared_ptr<full_block_type> get_full_block_by_block_id(const block_id_type& block_id) override;
+      fc::thread*                get_next_stcp_crypto_thread() override;
+      void                       start_stcp_crypto_threads();
+      void                       stop_stcp_crypto_threads();
 
       fc::variant_object         network_get_info() const;
       fc::variant_object         network_get_usage_stats() const;
@@ -1109,6 +1123,8 @@ namespace graphene { namespace net {
       _active_sync_requests.insert(active_sync_requests_map::value_type(item_to_request, fc::time_point::now()));
       peer->last_sync_item_received_time = fc::time_point::now();
       peer->sync_items_requested_from_peer.insert(item_to_request);
+      peer->sync_batch_requested_time = peer->last_sync_item_received_time;
+      peer->sync_batch_size = 1;
       peer->send_message(fetch_items_message(item_id_to_request.item_type, std::vector<item_hash_t>{item_id_to_request.item_hash}));
     }
 
@@ -1123,6 +1139,8 @@ namespace graphene { namespace net {
         peer->last_sync_item_received_time = fc::time_point::now();
         peer->sync_items_requested_from_peer.insert(item_to_request);
       }
+      peer->sync_batch_requested_time = fc::time_point::now();
+      peer->sync_batch_size = items_to_request.size();
       peer->send_message(fetch_items_message(graphene::net::block_message_type, items_to_request));
     }
 
@@ -1142,6 +1160,112 @@ namespace graphene { namespace net {
       }
     }
 
+    uint32_t node_impl::get_sync_stripe_size_for_peer(const peer_connection_ptr& peer, double fastest_sync_blocks_per_second) const
+    {
+      const uint32_t maximum_stripe_size = _node_configuration.maximum_blocks_per_peer_during_syncing;
+      // peers we haven't measured yet get a full stripe so we learn their rate quickly
+      if (peer->sync_blocks_per_second <= 0 || fastest_sync_blocks_per_second <= 0)
+        return maximum_stripe_size;
+      const uint32_t minimum_stripe_size = std::min<uint32_t>(GRAPHENE_NET_MIN_BLOCKS_PER_PEER_DURING_SYNCING, maximum_stripe_size);
+      const uint32_t stripe_size = (uint32_t)(maximum_stripe_size * (peer->sync_blocks_per_second / fastest_sync_blocks_per_second));
+      return std::max(minimum_stripe_size, std::min(stripe_size, maximum_stripe_size));
+    }
+
+    bool node_impl::restripe_sync_requests_from_slow_peers()
+    {
+      VERIFY_CORRECT_THREAD();
+      if (_suspend_fetching_sync_blocks)
+        return false; // nothing would be requested anyway until the backlog is processed
+
+      const fc::time_point now = fc::time_point::now();
+      bool restriped = false;
+      for (const peer_connection_ptr& peer : _active_connections)
+      {
+        if (peer->sync_items_requested_from_peer.empty() || !peer->sync_batch_size ||
+            now - peer->sync_batch_requested_time < fc::seconds(GRAPHENE_NET_SYNC_STRAGGLER_MIN_SECONDS))
+          continue;
+
+        double best_other_sync_blocks_per_second = 0;
+        for (const peer_connection_ptr& other_peer : _active_connections)
+          if (other_peer != peer && other_peer->we_need_sync_items_from_peer && !other_peer->inhibit_fetching_sync_blocks)
+            best_other_sync_blocks_per_second = std::max(best_other_sync_blocks_per_second, other_peer->sync_blocks_per_second);
+
+        const uint32_t blocks_received = peer->sync_batch_size - std::min<uint32_t>(peer->sync_batch_size, peer->sync_items_requested_from_peer.size());
+        const double current_sync_blocks_per_second = blocks_received / ((double)(now - peer->sync_batch_requested_time).count() / fc::seconds(1).count());
+        if (current_sync_blocks_per_second * GRAPHENE_NET_SYNC_STRAGGLER_FACTOR >= best_other_sync_blocks_per_second)
+          continue;
+
+        fc_ilog(fc::logger::get("sync"), "Re-striping ${count} sync blocks from slow peer ${peer} (${rate} blocks/s, best other peer ${best_rate} blocks/s)",
+                ("count", peer->sync_items_requested_from_peer.size())("peer", peer->get_remote_endpoint())
+                ("rate", current_sync_blocks_per_second)("best_rate", best_other_sync_blocks_per_second));
+        peer->update_sync_throughput(blocks_received, now);
+        // keep accepting these blocks from the slow peer in case they still win the race, but let other peers fetch them too
+        for (const item_hash_t& sync_item : peer->sync_items_requested_from_peer)
+        {
+          _active_sync_requests.erase(sync_item);
+          peer->sync_items_restriped_from_peer[sync_item] = now;
+        }
+        peer->sync_items_requested_from_peer.clear();
+        restriped = true;
+      }
+
+      if (restriped)
+        for (const peer_connection_ptr& peer : _active_connections)
+          peer->reset_id_search_for_peer();
+      return restriped;
+    }
+
+    bool node_impl::is_duplicate_sync_item(const std::shared_ptr<full_block_type>& full_block)
+    {
+      const block_id_type& block_id = full_block->get_block_id();
+      if (have_already_received_sync_item(block_id))
+        return true; // the other copy is still waiting in the backlog
+      // if no peer expects the block anymore, the other copy was already passed to the blockchain
+      const uint32_t block_num = full_block->get_block_num();
+      for (const peer_connection_ptr& peer : _active_connections)
+      {
+        uint32_t id_index = block_num - peer->first_id_block_number;
+        if (id_index < peer->ids_of_items_to_get.size() && peer->ids_of_items_to_get[id_index] == block_id)
+          return false;
+      }
+      return true;
+    }
+
+    bool node_impl::is_sync_item_available_from_other_peer(const peer_connection_ptr& peer, const item_hash_t& item_hash, uint32_t block_num) const
+    {
+      for (const peer_connection_ptr& other_peer : _active_connections)
+      {
+        if (other_peer == peer || !other_peer->we_need_sync_items_from_peer || other_peer->inhibit_fetching_sync_blocks)
+          continue;
+        uint32_t id_index = block_num - other_peer->first_id_block_number;
+        if (id_index < other_peer->ids_of_items_to_get.size() && other_peer->ids_of_items_to_get[id_index] == item_hash)
+          return true;
+      }
+      return false;
+    }
+
+    size_t node_impl::count_outstanding_restriped_sync_items(const peer_connection_ptr& peer, const fc::time_point& prune_threshold)
+    {
+      size_t outstanding_count = 0;
+      for (auto iter = peer->sync_items_restriped_from_peer.begin(); iter != peer->sync_items_restriped_from_peer.end();)
+      {
+        // still outstanding if nobody delivered the block yet and we still need it from this peer
+        const uint32_t block_num = _delegate->get_block_number(iter->first);
+        const uint32_t id_index = block_num - peer->first_id_block_number;
+        if (!have_already_received_sync_item(iter->first) &&
+            id_index < peer->ids_of_items_to_get.size() && peer->ids_of_items_to_get[id_index] == iter->first)
+        {
+          ++outstanding_count;
+          ++iter;
+        }
+        else if (iter->second < prune_threshold)
+          iter = peer->sync_items_restriped_from_peer.erase(iter); // a copy arriving this late would be treated as unrequested
+        else
+          ++iter;
+      }
+      return outstanding_count;
+    }
+
     void node_impl::fetch_sync_items_loop()
     {
       while (!_fetch_sync_items_loop_done.canceled())
@@ -1157,7 +1281,11 @@ namespace graphene { namespace net {
             ASSERT_TASK_NOT_PREEMPTED();
             std::set<item_hash_t> sync_items_to_request;
 
-            // for each idle peer that we're syncing with
+            // blocks released from a slow peer go back to it if no other peer fetched them in the time any peer gets to deliver
+            const fc::time_point restriped_sync_item_retry_threshold = fc::time_point::now() - fc::microseconds(_node_configuration.active_ignored_request_timeout_microseconds);
+            std::vector<peer_connection_ptr> peers_to_sync_from;
+            double fastest_sync_blocks_per_second = 0;
+            bool skipped_restriped_items = false;
             for( const peer_connection_ptr& peer : _active_connections )
             {
               if (peer->inhibit_fetching_sync_blocks)
@@ -1168,41 +1296,67 @@ namespace graphene { namespace net {
                 dlog("peer ${peer} is idle", ("peer", peer->get_remote_endpoint()));
                 ++idle_peer_count;
                 if (peer->we_need_sync_items_from_peer && !peer->ids_of_items_to_get.empty())
+                  peers_to_sync_from.push_back(peer);
+              }
+              if (peer->we_need_sync_items_from_peer)
+                fastest_sync_blocks_per_second = std::max(fastest_sync_blocks_per_second, peer->sync_blocks_per_second);
+            }
+            // the fastest peers take the lowest block ranges, so the blocks the backlog waits on arrive first;
+            // peers without measured rate go last
+            std::stable_sort(peers_to_sync_from.begin(), peers_to_sync_from.end(),
+                             [](const peer_connection_ptr& lhs, const peer_connection_ptr& rhs) { return lhs->sync_blocks_per_second > rhs->sync_blocks_per_second; });
+
+            // for each idle peer that we're syncing with
+            for( const peer_connection_ptr& peer : peers_to_sync_from )
+            {
+              const uint32_t stripe_size = get_sync_stripe_size_for_peer(peer, fastest_sync_blocks_per_second);
+              assert(peer->first_id_block_number);
+              if (peer->last_requested_block_number_for_peers_on_this_fork < peer->first_id_block_number - 1)
+                peer->last_requested_block_number_for_peers_on_this_fork = peer->first_id_block_number - 1;
+              uint32_t first_to_get = peer->last_requested_block_number_for_peers_on_this_fork - peer->first_id_block_number + 1;
+              if (first_to_get < peer->ids_of_items_to_get.size())
+              {
+                // loop through the items peer has that we don't yet have on our blockchain
+                unsigned i = first_to_get;
+                for (; i < peer->ids_of_items_to_get.size(); ++i)
                 {
-                  assert(peer->first_id_block_number);
-                  if (peer->last_requested_block_number_for_peers_on_this_fork < peer->first_id_block_number - 1)
-                    peer->last_requested_block_number_for_peers_on_this_fork = peer->first_id_block_number - 1;
-                  uint32_t first_to_get = peer->last_requested_block_number_for_peers_on_this_fork - peer->first_id_block_number + 1;
-                  if (first_to_get < peer->ids_of_items_to_get.size())
+                  const item_hash_t& item_to_potentially_request = peer->ids_of_items_to_get[i];
+                  // if we don't already have this item in our temporary storage and we haven't requested from another syncing peer
+                  if(_active_sync_requests.find(item_to_potentially_request) == _active_sync_requests.end() && // we've requested it in a previous iteration and we're still waiting for it to arrive
+                     !have_already_received_sync_item(item_to_potentially_request) && // already received it, but not yet removed from our list of peer items to get
+                     sync_items_to_request.find(item_to_potentially_request) == sync_items_to_request.end()) // we have already decided to request it from another peer during this iteration
                   {
-                    // loop through the items peer has that we don't yet have on our blockchain
-                    unsigned i = first_to_get;
-                    for (; i < peer->ids_of_items_to_get.size(); ++i)
+                    auto restriped_iter = peer->sync_items_restriped_from_peer.find(item_to_potentially_request);
+                    if (restriped_iter != peer->sync_items_restriped_from_peer.end() &&
+                        restriped_iter->second >= restriped_sync_item_retry_threshold &&
+                        is_sync_item_available_from_other_peer(peer, item_to_potentially_request, peer->first_id_block_number + i))
                     {
-                      const item_hash_t& item_to_potentially_request = peer->ids_of_items_to_get[i];
-                      // if we don't already have this item in our temporary storage and we haven't requested from another syncing peer
-                      if(_active_sync_requests.find(item_to_potentially_request) == _active_sync_requests.end() && // we've requested it in a previous iteration and we're still waiting for it to arrive
-                         !have_already_received_sync_item(item_to_potentially_request) && // already received it, but not yet removed from our list of peer items to get
-                         sync_items_to_request.find(item_to_potentially_request) == sync_items_to_request.end()) // we have already decided to request it from another peer during this iteration
-                      {
-                        // then schedule a request from this peer
-                        sync_item_requests_to_send[peer].push_back(item_to_potentially_request);
-                        sync_items_to_request.insert(item_to_potentially_request);
-                        if (sync_item_requests_to_send[peer].size() >= _node_configuration.maximum_blocks_per_peer_during_syncing)
-                          break;
-                      }
-                    } //for each item to get
-                    if (i == peer->ids_of_items_to_get.size()) //if we didn't find any items, we only searched one less than i
-                      --i;
-                    uint32_t last_searched_block_number = peer->first_id_block_number + i;
-                    const item_hash_t& last_searched_item_id = peer->ids_of_items_to_get[i];
-                    update_last_requested_block_number_for_peers_on_this_fork(last_searched_block_number, last_searched_item_id);
-                    dlog("searched through ${count} ids from ${total_ids} available ids to find ${n} items to request", ("count", i - first_to_get + 1)("total_ids", peer->ids_of_items_to_get.size())("n", sync_item_requests_to_send[peer].size()));
-
-                  } //if this peer has items we aren't currently asking for or already received
-                } //if we need sync items from peer
-              } //if peer idle
-            } //for each active peer
+                      skipped_restriped_items = true; // this peer was too slow to deliver it, leave it for another one
+                      continue;
+                    }
+                    // otherwise ask this peer again; the re-striped entry stays, so the copy sent in reply to
+                    // the original request is still accepted
+                    // then schedule a request from this peer
+                    sync_item_requests_to_send[peer].push_back(item_to_potentially_request);
+                    sync_items_to_request.insert(item_to_potentially_request);
+                    if (sync_item_requests_to_send[peer].size() >= stripe_size)
+                      break;
+                  }
+                } //for each item to get
+                if (i == peer->ids_of_items_to_get.size()) //if we didn't find any items, we only searched one less than i
+                  --i;
+                uint32_t last_searched_block_number = peer->first_id_block_number + i;
+                const item_hash_t& last_searched_item_id = peer->ids_of_items_to_get[i];
+                update_last_requested_block_number_for_peers_on_this_fork(last_searched_block_number, last_searched_item_id);
+                dlog("searched through ${count} ids from ${total_ids} available ids to find ${n} items to request", ("count", i - first_to_get + 1)("total_ids", peer->ids_of_items_to_get.size())("n", sync_item_requests_to_send[peer].size()));
+
+              } //if this peer has items we aren't currently asking for or already received
+            } //for each idle peer we need sync items from
+
+            // the search position is shared by peers on the same fork, don't let it move past blocks nobody took
+            if (skipped_restriped_items)
+              for (const peer_connection_ptr& peer : _active_connections)
+                peer->reset_id_search_for_peer();
           }// end non-preemptable section
 
           // make all the requests we scheduled in the loop above
@@ -1539,17 +1693,20 @@ namespace graphene { namespace net {
           else
           {
             bool disconnect_due_to_request_timeout = false;
-            if (!active_peer->sync_items_requested_from_peer.empty() &&
+            // blocks released to other peers because this one was too slow still count until somebody delivers them
+            const size_t remaining_sync_item_count = active_peer->sync_items_requested_from_peer.size() +
+              count_outstanding_restriped_sync_items(active_peer, active_ignored_request_threshold);
+            if (remaining_sync_item_count &&
                 active_peer->last_sync_item_received_time < active_ignored_request_threshold)
             {
               fc_wlog(fc::logger::get("sync"),
                       "disconnecting peer ${peer} because they haven't made any progress on my remaining ${count} sync item requests",
-                      ("peer", active_peer->get_remote_endpoint())("count", active_peer->sync_items_requested_from_peer.size()));
+                      ("peer", active_peer->get_remote_endpoint())("count", remaining_sync_item_count));
               wlog("Disconnecting peer ${peer} because they haven't made any progress on my remaining ${count} sync item requests",
-                   ("peer", active_peer->get_remote_endpoint())("count", active_peer->sync_items_requested_from_peer.size()));
+                   ("peer", active_peer->get_remote_endpoint())("count", remaining_sync_item_count));
 
               active_peer->connection_closed_error = fc::exception(FC_LOG_MESSAGE(warn, "Disconnecting peer because they haven't made any progress on my remaining ${count} sync item requests", 
-                                                                                  ("count", active_peer->sync_items_requested_from_peer.size())));
+                                                                                  ("count", remaining_sync_item_count)));
               disconnect_due_to_request_timeout = true;
             }
             if (!disconnect_due_to_request_timeout &&
@@ -1674,6 +1831,9 @@ namespace graphene { namespace net {
                            offsetof(current_time_request_message, request_sent_time));
       peers_to_send_keep_alive.clear();
 
+      if (restripe_sync_requests_from_slow_peers())
+        trigger_fetch_sync_items_loop();
+
       if (!node_is_shutting_down() && !_terminate_inactive_connections_loop_done.canceled())
          _terminate_inactive_connections_loop_done = schedule_task( [this](){ terminate_inactive_connections_loop(); },
                                                                    fc::time_point::now() + fc::seconds(1),
@@ -1980,6 +2140,7 @@ namespace graphene { namespace net {
         break;
       case core_message_type_enum::block_message_type:
       case core_message_type_enum::compressed_block_message_type:
+      case core_message_type_enum::compact_block_message_type:
         fc::async( [=]() { process_block_message(originating_peer, received_message, message_hash); }, "process_block_msg");
         break;
       case core_message_type_enum::trx_message_type:
@@ -2949,8 +3110,13 @@ namespace graphene { namespace net {
            ("type", fetch_items_message_received.item_type)
            ("endpoint", originating_peer->get_remote_endpoint()));
 
-      if (fetch_items_message_received.item_type == block_message_type)
+      // a request for compressed_block_message_type comes from a peer that couldn't rebuild a compact block
+      // we sent it, answer it like a regular block request, just never with another compact block
+      if (fetch_items_message_received.item_type == block_message_type ||
+          fetch_items_message_received.item_type == compressed_block_message_type)
       {
+        const bool allow_compact_blocks = fetch_items_message_received.item_type == block_message_type;
+        const fc::time_point_sec oldest_compact_block_time = fc::time_point::now() - fc::seconds(GRAPHENE_NET_MAX_COMPACT_BLOCK_AGE);
         std::vector<std::shared_ptr<full_block_type>> reply_blocks;
         reply_blocks.reserve(fetch_items_message_received.items_to_fetch.size());
         std::shared_ptr<full_block_type> last_full_block_sent;
@@ -2999,7 +3165,8 @@ namespace graphene { namespace net {
         assert(reply_blocks.size() == fetch_items_message_received.items_to_fetch.size());
         for (unsigned i = 0; i < reply_blocks.size(); ++i)
           if (reply_blocks[i])
-            originating_peer->send_block_message(reply_blocks[i]);
+            originating_peer->send_block_message(reply_blocks[i], allow_compact_blocks &&
+                                                                  reply_blocks[i]->get_block_header().timestamp >= oldest_compact_block_time);
           else
             originating_peer->send_message(item_not_available_message(item_id(block_message_type, fetch_items_message_received.items_to_fetch[i])));
 
@@ -3876,6 +4043,44 @@ namespace graphene { namespace net {
           ++originating_peer->compressed_blocks_received_from_peer;
           break;
         }
+      case core_message_type_enum::compact_block_message_type:
+        {
+          // a malformed compact block is handled like an invalid block: we can't rebuild it, so the peer
+          // that sent it gets disconnected and the block is fetched from someone else
+          try
+          {
+            const compact_block_message compact_block = message_to_process.as<compact_block_message>();
+            const block_id_type block_id = full_block_type::compute_block_id(compact_block.header);
+
+            // rebuilding may end up asking the peer for the full block, so only do it for blocks we've asked for
+            if (originating_peer->sync_items_requested_from_peer.find(block_id) == originating_peer->sync_items_requested_from_peer.end() &&
+                originating_peer->sync_items_restriped_from_peer.find(block_id) == originating_peer->sync_items_restriped_from_peer.end() &&
+                originating_peer->items_requested_from_peer.find(item_id(graphene::net::block_message_type, block_id)) == originating_peer->items_requested_from_peer.end())
+            {
+              wlog("received a compact block ${block_id} I didn't ask for from peer ${endpoint}, disconnecting from peer",
+                   ("endpoint", originating_peer->get_remote_endpoint())(block_id));
+              fc::exception detailed_error(FC_LOG_MESSAGE(error, "You sent me a block that I didn't ask for, block_id: ${block_id}", (block_id)));
+              disconnect_from_peer(originating_peer, "You sent me a block that I didn't ask for", true, detailed_error);
+              return;
+            }
+
+            full_block = reconstruct_compact_block(originating_peer, compact_block, block_id);
+          }
+          catch (const fc::canceled_exception&)
+          {
+            throw;
+          }
+          catch (const fc::exception& e)
+          {
+            wlog("Failed to rebuild compact block sent by peer ${endpoint}: ${e}", ("endpoint", originating_peer->get_remote_endpoint())(e));
+            disconnect_from_peer(originating_peer, "You offered me a block that I have deemed to be invalid", true, e);
+            return;
+          }
+          if (!full_block)
+            return; // we've asked the peer for the full block, it will be processed once it arrives
+          ++originating_peer->compact_blocks_received_from_peer;
+          break;
+        }
       default:
         FC_THROW("unrecognized block message type ${type}", ("type", message_to_process.msg_type));
       }
@@ -3884,19 +4089,31 @@ namespace graphene { namespace net {
       // (it's possible that we request an item during normal operation and then get kicked into sync
       // mode before we receive and process the item.  In that case, we should process the item as a normal
       // item to avoid confusing the sync code)
+      bool is_sync_block = false;
       auto sync_item_iter = originating_peer->sync_items_requested_from_peer.find(full_block->get_block_id());
       if (sync_item_iter != originating_peer->sync_items_requested_from_peer.end())
       {
-        // it's a sync block
         originating_peer->sync_items_requested_from_peer.erase(sync_item_iter);
+        is_sync_block = true;
+      }
+      else // sync block we re-striped to other peers because this one was slow
+        is_sync_block = originating_peer->sync_items_restriped_from_peer.erase(full_block->get_block_id()) != 0;
+      if (is_sync_block)
+      {
+        // it's a sync block
         // if exceptions are throw here after removing the sync item from the list (above),
         // it could leave our sync in a stalled state.  Wrap a try/catch around the rest
         // of the function so we can log if this ever happens.
         try
         {
           originating_peer->last_sync_item_received_time = fc::time_point::now();
-          _active_sync_requests.erase(full_block->get_block_id());
-          process_block_during_sync(originating_peer, full_block);
+          if (originating_peer->sync_items_requested_from_peer.empty() && originating_peer->sync_batch_size)
+            originating_peer->update_sync_throughput(originating_peer->sync_batch_size, originating_peer->last_sync_item_received_time);
+          // re-striped blocks can arrive twice, only the first copy goes to the backlog
+          if (_active_sync_requests.erase(full_block->get_block_id()) || !is_duplicate_sync_item(full_block))
+            process_block_during_sync(originating_peer, full_block);
+          else
+            dlog("discarding duplicate sync block ${id} from ${peer}", ("id", full_block->get_block_id())("peer", originating_peer->get_remote_endpoint()));
           if (originating_peer->idle())
           {
             // we have finished fetching a batch of items, so we either need to grab another batch of items
@@ -3966,6 +4183,30 @@ namespace graphene { namespace net {
       disconnect_from_peer(originating_peer, "You sent me a block that I didn't ask for", true, detailed_error);
     }
 
+    std::shared_ptr<full_block_type> node_impl::reconstruct_compact_block(peer_connection* originating_peer, const compact_block_message& compact_block, const block_id_type& block_id)
+    {
+      VERIFY_CORRECT_THREAD();
+      uint32_t missing_transaction_count = 0;
+      std::shared_ptr<full_block_type> full_block = compact_block.rebuild_block(missing_transaction_count);
+      if (full_block)
+      {
+        _thread_pool.enqueue_work(full_block, hive::chain::blockchain_worker_thread_pool::data_source_type::block_received_from_p2p);
+        return full_block;
+      }
+
+      if (missing_transaction_count == 0)
+        dlog("compact block ${id} from peer ${endpoint} rebuilt with wrong transactions (short id collision), requesting full block",
+             ("id", block_id)("endpoint", originating_peer->get_remote_endpoint()));
+      else
+        dlog("missing ${missing_transaction_count} of ${transaction_count} transactions of compact block ${id} from peer ${endpoint}, requesting full block",
+             (missing_transaction_count)("transaction_count", compact_block.short_transaction_ids.size() + compact_block.prefilled_transactions.size())
+             ("id", block_id)("endpoint", originating_peer->get_remote_endpoint()));
+
+      // the block stays in items_requested_from_peer, so the full block will be processed as the one we asked for
+      originating_peer->send_message(fetch_items_message(compressed_block_message_type, {block_id}));
+      return std::shared_ptr<full_block_type>();
+    }
+
     void node_impl::process_trx_message(peer_connection* originating_peer,
                                         const trx_message& transaction_message_to_process)
     {
@@ -4581,6 +4822,21 @@ namespace graphene { namespace net {
         _peers_to_delete.clear();
       }
 
+      // all connections are destroyed, so no socket can hand cipher work to the crypto threads anymore
+      try
+      {
+        stop_stcp_crypto_threads();
+        dlog("Stcp crypto threads terminated");
+      }
+      catch ( const fc::exception& e )
+      {
+        wlog( "Exception thrown while terminating stcp crypto threads, ignoring: ${e}", ("e", e) );
+      }
+      catch (...)
+      {
+        wlog( "Exception thrown while terminating stcp crypto threads, ignoring" );
+      }
+
       // Now that there are no more peers that can call methods on us, there should be no
       // chance for one of our loops to be rescheduled, so we can safely terminate all of
       // our loops now
@@ -5327,9 +5583,12 @@ namespace graphene { namespace net {
           ilog( "    peer.time_since_inventory_requested: ${time}ms", ("time", (fc::time_point::now() - peer->item_ids_requested_from_peer->get<1>()).count() / 1000));
         ilog( "    peer.items_requested_from_peer size: ${size}", ("size", peer->items_requested_from_peer.size() ) );
         ilog( "    peer.sync_items_requested_from_peer size: ${size}", ("size", peer->sync_items_requested_from_peer.size() ) );
+        ilog( "    peer.sync_items_restriped_from_peer size: ${size}, sync rate: ${rate} blocks/s",
+              ("size", peer->sync_items_restriped_from_peer.size())("rate", peer->sync_blocks_per_second) );
         ilog( "    peer.time_since_last_sync_item_received: ${time_since_last_sync_item_received}ms", ("time_since_last_sync_item_received", (fc::time_point::now() - peer->last_sync_item_received_time).count() / 1000));
-        ilog( "    peer.blocks_received_from_peer: ${compressed} compressed, ${uncompressed} uncompressed",
-              ("compressed", peer->compressed_blocks_received_from_peer)("uncompressed", peer->uncompressed_blocks_received_from_peer));
+        ilog( "    peer.blocks_received_from_peer: ${compressed} compressed, ${uncompressed} uncompressed, ${compact} compact",
+              ("compressed", peer->compressed_blocks_received_from_peer)("uncompressed", peer->uncompressed_blocks_received_from_peer)
+              ("compact", peer->compact_blocks_received_from_peer));
       }
       ilog( "--------- END MEMORY USAGE ------------" );
 
@@ -5670,9 +5929,44 @@ namespace graphene { namespace net {
 
       while (_active_connections.size() > _node_configuration.maximum_number_of_connections)
         disconnect_from_peer(_active_connections.begin()->get(), "I have too many connections open");
+
+      start_stcp_crypto_threads();
+
       trigger_p2p_network_connect_loop();
     }
 
+    void node_impl::start_stcp_crypto_threads()
+    {
+      VERIFY_CORRECT_THREAD();
+      if (!_stcp_crypto_threads.empty())
+      {
+        // existing connections hold on to their threads, so they can't be replaced while the node runs
+        if (_stcp_crypto_threads.size() != _node_configuration.stcp_crypto_threads)
+          wlog("Number of stcp crypto threads can't be changed while node is running, keeping ${n}", ("n", _stcp_crypto_threads.size()));
+        return;
+      }
+      ilog("Starting ${n} stcp crypto threads", ("n", _node_configuration.stcp_crypto_threads));
+      for (uint32_t i = 0; i < _node_configuration.stcp_crypto_threads; ++i)
+        _stcp_crypto_threads.emplace_back(std::make_unique<fc::thread>("stcp_crypto_" + std::to_string(i)));
+    }
+
+    void node_impl::stop_stcp_crypto_threads()
+    {
+      VERIFY_CORRECT_THREAD();
+      for (const std::unique_ptr<fc::thread>& crypto_thread : _stcp_crypto_threads)
+        crypto_thread->quit();
+      _stcp_crypto_threads.clear();
+    }
+
+    fc::thread* node_impl::get_next_stcp_crypto_thread()
+    {
+      VERIFY_CORRECT_THREAD();
+      // connections made before the threads are started (or with none configured) do their cipher work inline
+      if (_stcp_crypto_threads.empty())
+        return nullptr;
+      return _stcp_crypto_threads[_next_stcp_crypto_thread++ % _stcp_crypto_threads.size()].get();
+    }
+
     node_configuration node_impl::get_advanced_node_parameters()const
     {
       VERIFY_CORRECT_THREAD();
@@ -62,6 +62,12 @@ namespace graphene { namespace net
     }
     message peer_connection::virtual_queued_block_message::get_message(peer_connection_delegate* node, peer_connection* peer)
     {
+      // compact blocks need the block's transactions, which are only there if the block was decoded already
+      if (allow_compact_block && peer->supports_compact_blocks() && full_block->has_decoded_block())
+        return compact_block_message(full_block, [peer](const full_transaction_type& full_transaction) {
+          return peer->has_seen_transaction(full_transaction);
+        });
+
       if (peer->supports_compressed_blocks())
       {
         // the peer can handle some form of compressed data.
@@ -102,6 +108,7 @@ namespace graphene { namespace net
 #endif
       _currently_handling_message(false)
     {
+      _message_connection.set_crypto_thread(_node->get_next_stcp_crypto_thread());
     }
 
     peer_connection_ptr peer_connection::make_shared(peer_connection_delegate* delegate)
@@ -386,10 +393,10 @@ namespace graphene { namespace net
       send_queueable_message(std::move(message_to_enqueue));
     }
 
-    void peer_connection::send_block_message(const std::shared_ptr<full_block_type>& full_block)
+    void peer_connection::send_block_message(const std::shared_ptr<full_block_type>& full_block, bool allow_compact_block)
     {
       VERIFY_CORRECT_THREAD();
-      send_queueable_message(std::make_unique<virtual_queued_block_message>(full_block));
+      send_queueable_message(std::make_unique<virtual_queued_block_message>(full_block, allow_compact_block));
     }
 
     void peer_connection::close_connection()
@@ -461,6 +468,16 @@ namespace graphene { namespace net
       return !busy();
     }
 
+    void peer_connection::update_sync_throughput(uint32_t blocks_received, const fc::time_point& now)
+    {
+      VERIFY_CORRECT_THREAD();
+      const double elapsed_seconds = std::max<double>((now - sync_batch_requested_time).count(), 1000) / fc::seconds(1).count();
+      const double batch_rate = blocks_received / elapsed_seconds;
+      // smooth over a few batches, the first sample is taken as is
+      sync_blocks_per_second = sync_blocks_per_second > 0 ? (sync_blocks_per_second + batch_rate) / 2 : batch_rate;
+      sync_batch_size = 0;
+    }
+
     bool peer_connection::is_currently_handling_message() const
     {
       VERIFY_CORRECT_THREAD();
@@ -541,6 +558,18 @@ namespace graphene { namespace net
       return core_protocol_version >= GRAPHENE_NET_PROTOCOL_COMPRESSED_BLOCKS_VERSION;
     }
 
+    bool peer_connection::supports_compact_blocks() const
+    {
+      return core_protocol_version >= GRAPHENE_NET_PROTOCOL_COMPACT_BLOCKS_VERSION;
+    }
+
+    bool peer_connection::has_seen_transaction(const full_transaction_type& full_transaction) const
+    {
+      const item_id transaction_item(trx_message_type, full_transaction.get_legacy_transaction_message_hash());
+      return inventory_peer_advertised_to_us.find(transaction_item) != inventory_peer_advertised_to_us.end() ||
+             inventory_advertised_to_peer.find(transaction_item) != inventory_advertised_to_peer.end();
+    }
+
     bool peer_connection::advertise_blocks_by_block_id() const
     {
       return core_protocol_version >= GRAPHENE_NET_PROTOCOL_ADVERTISE_BLOCKS_BY_BLOCK_ID_VERSION;
@@ -31,15 +31,21 @@
 #include <fc/log/logger.hpp>
 #include <fc/network/ip.hpp>
 #include <fc/exception/exception.hpp>
+#include <fc/thread/thread.hpp>
 
 #include <graphene/net/stcp_socket.hpp>
+#include <graphene/net/config.hpp>
 
 namespace graphene { namespace net {
 
 stcp_socket::stcp_socket()
 //:_buf_len(0)
+   : _send_aes(std::make_shared<fc::aes_encoder>()),
+     _recv_aes(std::make_shared<fc::aes_decoder>()),
+     _crypto_thread(nullptr),
+     _cipher_job_abandoned(false)
 #ifndef NDEBUG
-   : _read_buffer_in_use(false),
+   , _read_buffer_in_use(false),
      _write_buffer_in_use(false)
 #endif
 {
@@ -62,13 +68,44 @@ void stcp_socket::do_key_exchange()
 
   _shared_secret = _priv_key.get_shared_secret( rpub );
 //    ilog("shared secret ${s}", ("s", shared_secret) );
-  _send_aes.init( fc::sha256::hash( (char*)&_shared_secret, sizeof(_shared_secret) ), 
+  _send_aes->init( fc::sha256::hash( (char*)&_shared_secret, sizeof(_shared_secret) ), 
                   fc::city_hash_crc_128((char*)&_shared_secret,sizeof(_shared_secret) ) );
-  _recv_aes.init( fc::sha256::hash( (char*)&_shared_secret, sizeof(_shared_secret) ), 
+  _recv_aes->init( fc::sha256::hash( (char*)&_shared_secret, sizeof(_shared_secret) ), 
                   fc::city_hash_crc_128((char*)&_shared_secret,sizeof(_shared_secret) ) );
 }
 
 
+/**
+ *   The cipher runs on the crypto thread of this socket when there is enough data to make
+ *   the hand off worth it; the calling task yields to other tasks of the p2p thread meanwhile.
+ *   Only one read and one write are in progress on a socket at a time and each direction has
+ *   its own cipher context, so no further synchronization is needed.
+ */
+bool stcp_socket::should_offload_cipher( size_t len ) const
+{
+  return _crypto_thread != nullptr && len >= GRAPHENE_NET_STCP_CRYPTO_OFFLOAD_THRESHOLD;
+}
+
+/**
+ *   The cipher operation has to hold shared pointers to everything it touches: a canceled caller
+ *   unwinds right away (a canceled task can't wait for anything in fc) while the job may still run.
+ */
+template<typename Functor>
+uint32_t stcp_socket::run_cipher_on_crypto_thread( Functor&& cipher_operation )
+{
+  fc::future<uint32_t> result = _crypto_thread->async( std::forward<Functor>(cipher_operation), "stcp_cipher" );
+  try
+  {
+    return result.wait();
+  }
+  catch( const fc::canceled_exception& )
+  {
+    // the abandoned job still advances the cipher context, nothing read or written later would match the peer's stream
+    _cipher_job_abandoned = true;
+    throw;
+  }
+}
+
 void stcp_socket::connect_to( const fc::ip::endpoint& remote_endpoint )
 {
   _sock.connect_to( remote_endpoint );
@@ -99,8 +136,9 @@ size_t stcp_socket::readsome( char* buffer, size_t len )
       ~check_buffer_in_use() { assert(_buffer_in_use); _buffer_in_use = false; }
     } buffer_in_use_checker(_read_buffer_in_use);
 #endif
+    FC_ASSERT( !_cipher_job_abandoned, "Cipher stream was interrupted by a canceled operation" );
 
-    const size_t read_buffer_length = 4096;
+    const size_t read_buffer_length = GRAPHENE_NET_STCP_BUFFER_SIZE;
     if (!_read_buffer)
       _read_buffer.reset(new char[read_buffer_length], [](char* p){ delete[] p; });
 
@@ -112,7 +150,16 @@ size_t stcp_socket::readsome( char* buffer, size_t len )
       _sock.read(_read_buffer, 16 - (s%16), s);
       s += 16-(s%16);
     }
-    _recv_aes.decode( _read_buffer.get(), s, buffer );
+    if( should_offload_cipher( s ) )
+    {
+      if( !_decrypted_buffer )
+        _decrypted_buffer.reset(new char[read_buffer_length], [](char* p){ delete[] p; });
+      run_cipher_on_crypto_thread( [recv_aes = _recv_aes, read_buffer = _read_buffer, decrypted_buffer = _decrypted_buffer, s]() {
+        return recv_aes->decode( read_buffer.get(), s, decrypted_buffer.get() ); } );
+      memcpy( buffer, _decrypted_buffer.get(), s );
+    }
+    else
+      _recv_aes->decode( _read_buffer.get(), s, buffer );
     return s;
 } FC_RETHROW_EXCEPTIONS( warn, "", ("len",len) ) }
 
@@ -140,8 +187,9 @@ size_t stcp_socket::writesome( const char* buffer, size_t len )
       ~check_buffer_in_use() { assert(_buffer_in_use); _buffer_in_use = false; }
     } buffer_in_use_checker(_write_buffer_in_use);
 #endif
+    FC_ASSERT( !_cipher_job_abandoned, "Cipher stream was interrupted by a canceled operation" );
 
-    const std::size_t write_buffer_length = 4096;
+    const std::size_t write_buffer_length = GRAPHENE_NET_STCP_BUFFER_SIZE;
     if (!_write_buffer)
       _write_buffer.reset(new char[write_buffer_length], [](char* p){ delete[] p; });
     len = std::min<size_t>(write_buffer_length, len);
@@ -152,7 +200,17 @@ size_t stcp_socket::writesome( const char* buffer, size_t len )
      * for now because we are going to upgrade to something
      * better.
      */
-    uint32_t ciphertext_len = _send_aes.encode( buffer, len, _write_buffer.get() );
+    uint32_t ciphertext_len;
+    if( should_offload_cipher( len ) )
+    {
+      if( !_plaintext_buffer )
+        _plaintext_buffer.reset(new char[write_buffer_length], [](char* p){ delete[] p; });
+      memcpy( _plaintext_buffer.get(), buffer, len );
+      ciphertext_len = run_cipher_on_crypto_thread( [send_aes = _send_aes, plaintext_buffer = _plaintext_buffer, write_buffer = _write_buffer, len]() {
+        return send_aes->encode( plaintext_buffer.get(), len, write_buffer.get() ); } );
+    }
+    else
+      ciphertext_len = _send_aes->encode( buffer, len, _write_buffer.get() );
     assert(ciphertext_len == len);
     _sock.write( _write_buffer, ciphertext_len );
     return ciphertext_len;
@@ -50,6 +50,7 @@ namespace bpo = boost::program_options;
 #define HIVE_NAMESPACE_PREFIX "hive::protocol::"
 
 #define WRITE_BUFFER_FLUSH_LIMIT     10
+#define BULK_IMPORT_WRITE_BUFFER_FLUSH_LIMIT 1000
 #define ACCOUNT_HISTORY_LENGTH_LIMIT 30
 #define ACCOUNT_HISTORY_TIME_LIMIT   30
 
@@ -194,12 +195,13 @@ public:
   bool find_operation_object(size_t opId, rocksdb_operation_object* op) const;
   /// Allows to look for all operations present in given block and call `processor` for them.
   void find_operations_by_block(size_t blockNum, bool include_reversible,
-    std::function<void(const rocksdb_operation_object&)> processor) const;
+    std::function<void(const rocksdb_operation_object&)> processor, const operation_type_filter& acceptOpType) const;
   /// Allows to enumerate all operations registered in given block range.
   std::pair< uint32_t/*nr last block*/, uint64_t/*operation-id to resume from*/ > enumVirtualOperationsFromBlockRange(
     uint32_t blockRangeBegin, uint32_t blockRangeEnd, bool include_reversible,
     fc::optional<uint64_t> operationBegin, fc::optional<uint32_t> limit,
-    std::function<bool(const rocksdb_operation_object&, uint64_t, bool)> processor) const;
+    std::function<bool(const rocksdb_operation_object&, uint64_t, bool)> processor,
+    const operation_type_filter& acceptOpType) const;
 
   bool find_transaction_info(const protocol::transaction_id_type& trxId, bool include_reversible, uint32_t* blockNo,
     uint32_t* txInBlock) const;
@@ -210,6 +212,12 @@ public:
 
 private:
 
+  /// Operation type is stored in the lowest 8 bits of operation id - see build_next_operation_id.
+  static int64_t get_operation_type(uint64_t operationId)
+  {
+    return operationId & 0xFF;
+  }
+
   uint64_t build_next_operation_id(const rocksdb_operation_object& obj, const hive::protocol::operation& processed_op)
   {
     auto number_in_block = _provider->get_operationSeqId();
@@ -343,7 +351,8 @@ private:
   /** Limit which value depends on block data source:
     *    - if blocks come from network, there is no need for delaying write, becasue they appear quite rare (limit == 1)
     *    - if reindex process or direct import has been spawned, this massive operation can need reduction of direct
-        writes (limit == WRITE_BUFFER_FLUSH_LIMIT).
+        writes (limit == WRITE_BUFFER_FLUSH_LIMIT, or BULK_IMPORT_WRITE_BUFFER_FLUSH_LIMIT when batches are written
+        in background).
     */
   unsigned int                     _collectedOpsWriteLimit = 1;
 
@@ -705,7 +714,7 @@ bool account_history_rocksdb_plugin::impl::find_operation_object(size_t opId, ro
 }
 
 void account_history_rocksdb_plugin::impl::find_operations_by_block(size_t blockNum, bool include_reversible,
-  std::function<void(const rocksdb_operation_object&)> processor) const
+  std::function<void(const rocksdb_operation_object&)> processor, const operation_type_filter& acceptOpType) const
 {
   if(include_reversible)
   {
@@ -731,6 +740,9 @@ void account_history_rocksdb_plugin::impl::find_operations_by_block(size_t block
     auto valueSlice = it->value();
     const auto& opId = id_slice_t::unpackSlice(valueSlice);
 
+    if(acceptOpType && !acceptOpType(get_operation_type(opId)))
+      continue;
+
     rocksdb_operation_object op;
     bool found = find_operation_object(opId, &op);
     FC_ASSERT(found);
@@ -742,7 +754,8 @@ void account_history_rocksdb_plugin::impl::find_operations_by_block(size_t block
 std::pair< uint32_t, uint64_t > account_history_rocksdb_plugin::impl::enumVirtualOperationsFromBlockRange(
   uint32_t blockRangeBegin, uint32_t blockRangeEnd, bool include_reversible,
   fc::optional<uint64_t> resumeFromOperation, fc::optional<uint32_t> limit,
-  std::function<bool(const rocksdb_operation_object&, uint64_t, bool)> processor) const
+  std::function<bool(const rocksdb_operation_object&, uint64_t, bool)> processor,
+  const operation_type_filter& acceptOpType) const
 {
   constexpr static uint32_t block_range_limit = 2'000;
 
@@ -835,13 +848,6 @@ std::pair< uint32_t, uint64_t > account_history_rocksdb_plugin::impl::enumVirtua
     /// Accept only virtual operations
     if(key.second.is_virtual() && key.second.get_id() >= lastProcessedOperationId)
     {
-      auto valueSlice = it->value();
-      auto opId = id_slice_t::unpackSlice(valueSlice);
-
-      rocksdb_operation_object op;
-      bool found = find_operation_object(opId, &op);
-      FC_ASSERT(found);
-
       ///Number of retrieved operations can't be greater then limit
       if(limit.valid() && (cntLimit >= *limit))
       {
@@ -850,10 +856,21 @@ std::pair< uint32_t, uint64_t > account_history_rocksdb_plugin::impl::enumVirtua
         break;
       }
 
+      lastFoundBlock = key.first;
+
+      /// Key already tells the operation type, so filtered out operations are not loaded from storage
+      if(acceptOpType && !acceptOpType(get_operation_type(key.second.get_id())))
+        continue;
+
+      auto valueSlice = it->value();
+      auto opId = id_slice_t::unpackSlice(valueSlice);
+
+      rocksdb_operation_object op;
+      bool found = find_operation_object(opId, &op);
+      FC_ASSERT(found);
+
       if(processor(op, key.second.get_id(), true))
         ++cntLimit;
-
-      lastFoundBlock = key.first;
     }
   }
 
@@ -1077,7 +1094,10 @@ void account_history_rocksdb_plugin::impl::on_pre_reindex(const hive::chain::rei
 
   ilog("Setting write limit to massive level");
 
-  _collectedOpsWriteLimit = WRITE_BUFFER_FLUSH_LIMIT;
+  /// Pruning reads AH records directly from storage, so it needs all previous batches to be already written.
+  const bool bulkImport = !_prune;
+  _provider->setBulkImportMode( bulkImport );
+  _collectedOpsWriteLimit = bulkImport ? BULK_IMPORT_WRITE_BUFFER_FLUSH_LIMIT : WRITE_BUFFER_FLUSH_LIMIT;
 
   _lastTx = transaction_id_type();
   _txNo = 0;
@@ -1094,6 +1114,7 @@ void account_history_rocksdb_plugin::impl::on_post_reindex(const hive::chain::re
     ("b", note.last_block_number));
 
   _provider->flushDb();
+  _provider->setBulkImportMode( false );
   _collectedOpsWriteLimit = 1;
   _reindexing = false;
   uint32_t last_irreversible_block_num = _mainDb.get_last_irreversible_block_num();
@@ -1450,16 +1471,17 @@ bool account_history_rocksdb_plugin::find_operation_object(size_t opId, rocksdb_
 }
 
 void account_history_rocksdb_plugin::find_operations_by_block(size_t blockNum, bool include_reversible,
-  std::function<void(const rocksdb_operation_object&)> processor) const
+  std::function<void(const rocksdb_operation_object&)> processor, const operation_type_filter& acceptOpType) const
 {
-  _my->find_operations_by_block(blockNum, include_reversible, processor);
+  _my->find_operations_by_block(blockNum, include_reversible, processor, acceptOpType);
 }
 
 std::pair< uint32_t, uint64_t > account_history_rocksdb_plugin::enum_operations_from_block_range(uint32_t blockRangeBegin, uint32_t blockRangeEnd,
   bool include_reversible, fc::optional<uint64_t> operationBegin, fc::optional<uint32_t> limit,
-  std::function<bool(const rocksdb_operation_object&, uint64_t, bool)> processor) const
+  std::function<bool(const rocksdb_operation_object&, uint64_t, bool)> processor, const operation_type_filter& acceptOpType) const
 {
-  return _my->enumVirtualOperationsFromBlockRange(blockRangeBegin, blockRangeEnd, include_reversible, operationBegin, limit, processor);
+  return _my->enumVirtualOperationsFromBlockRange(blockRangeBegin, blockRangeEnd, include_reversible, operationBegin, limit, processor,
+    acceptOpType);
 }
 
 bool account_history_rocksdb_plugin::find_transaction_info(const protocol::transaction_id_type& trxId, bool include_reversible, uint32_t* blockNo,
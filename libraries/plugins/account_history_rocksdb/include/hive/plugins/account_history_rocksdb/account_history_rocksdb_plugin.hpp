@@ -17,7 +17,9 @@ namespace plugins { namespace account_history_rocksdb {
 
 namespace bfs = boost::filesystem;
 
-
+/// Decides if operations of given type (position in hive::protocol::operation) should be processed at all.
+/// Type of irreversible operation is encoded in its id, so rejected ones are skipped without loading their data.
+using operation_type_filter = std::function<bool(int64_t)>;
 
 class account_history_rocksdb_plugin final : public appbase::plugin< account_history_rocksdb_plugin >
 {
@@ -42,11 +44,13 @@ public:
     std::function<bool(unsigned int, const rocksdb_operation_object&)> processor) const;
   bool find_operation_object(size_t opId, rocksdb_operation_object* data) const;
   void find_operations_by_block(size_t blockNum, bool include_reversible,
-    std::function<void(const rocksdb_operation_object&)> processor) const;
+    std::function<void(const rocksdb_operation_object&)> processor,
+    const operation_type_filter& acceptOpType = operation_type_filter()) const;
   std::pair< uint32_t/*nr last block*/, uint64_t/*operation-id to resume from*/ > enum_operations_from_block_range(
     uint32_t blockRangeBegin, uint32_t blockRangeEnd, bool include_reversible,
     fc::optional<uint64_t> operationBegin, fc::optional<uint32_t> limit,
-    std::function<bool(const rocksdb_operation_object&, uint64_t, bool)> processor) const;
+    std::function<bool(const rocksdb_operation_object&, uint64_t, bool)> processor,
+    const operation_type_filter& acceptOpType = operation_type_filter()) const;
   bool find_transaction_info(const protocol::transaction_id_type& trxId, bool include_reversible, uint32_t* blockNo, uint32_t* txInBlock) const;
 
   bfs::path storage_dir() const;
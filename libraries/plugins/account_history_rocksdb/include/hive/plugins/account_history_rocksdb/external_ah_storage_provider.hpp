@@ -34,6 +34,9 @@ class external_ah_storage_provider: public external_snapshot_storage_provider
 
     virtual void flushWriteBuffer(DB* storage = nullptr) = 0;
 
+    /// In bulk import mode (reindex) write buffer is flushed in background, without use of write-ahead log.
+    virtual void setBulkImportMode( bool enable ) = 0;
+
     virtual ColumnFamilyHandle* getColumnHandle( Columns column ) = 0;
 
     virtual CachableWriteBatch& getCachableWriteBuffer() = 0;
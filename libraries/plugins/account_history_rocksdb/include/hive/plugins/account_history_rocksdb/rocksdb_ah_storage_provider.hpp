@@ -5,6 +5,8 @@
 
 #include <rocksdb/slice.h>
 
+#include <future>
+
 namespace hive { namespace chain {
 
 using ::rocksdb::ColumnFamilyHandle;
@@ -22,8 +24,16 @@ class rocksdb_ah_storage_provider: public rocksdb_storage_provider, public exter
 
     CachableWriteBatch _writeBuffer;
 
+    /// Set during reindex - see setBulkImportMode.
+    bool                             _bulkImport = false;
+    /// Batch being written by background writer (bulk import mode only) and result of that write.
+    WriteBatch                       _pendingWrite;
+    std::future<::rocksdb::Status>   _pendingWriteResult;
+
     void storeSequenceIds();
 
+    void waitForPendingWrite();
+
     void loadSeqIdentifiers(DB* storageDb) override;
 
     WriteBatch& getWriteBuffer() override;
@@ -64,6 +74,8 @@ class rocksdb_ah_storage_provider: public rocksdb_storage_provider, public exter
 
     void flushWriteBuffer(DB* storage = nullptr) override;
 
+    void setBulkImportMode( bool enable ) override;
+
     ColumnFamilyHandle* getColumnHandle( Columns column ) override;
 
     CachableWriteBatch& getCachableWriteBuffer() override;
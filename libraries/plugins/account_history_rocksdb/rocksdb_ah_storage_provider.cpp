@@ -52,12 +52,53 @@ WriteBatch& rocksdb_ah_storage_provider::getWriteBuffer()
 
 void rocksdb_ah_storage_provider::flushDb()
 {
+  waitForPendingWrite();
   rocksdb_storage_provider::flushDb();
 }
 
 void rocksdb_ah_storage_provider::flushWriteBuffer(DB* storage)
 {
-  rocksdb_storage_provider::flushWriteBuffer( storage );
+  if( !_bulkImport || storage != nullptr )
+  {
+    waitForPendingWrite();
+    rocksdb_storage_provider::flushWriteBuffer( storage );
+    return;
+  }
+
+  beforeFlushWriteBuffer();
+
+  /// Only one batch is written at a time, so the order of writes is preserved. Block processing continues
+  /// collecting next batch while previous one is being stored.
+  waitForPendingWrite();
+  _writeBuffer.detach( _pendingWrite );
+  _pendingWriteResult = std::async( std::launch::async, [this]() -> ::rocksdb::Status
+  {
+    ::rocksdb::WriteOptions wOptions;
+    /// Reindex is not resumable anyway (LIB is stored once it is finished), so WAL would be pure overhead.
+    /// Data is persisted by flushDb at the end of reindex.
+    wOptions.disableWAL = true;
+    return getStorage()->Write( wOptions, &_pendingWrite );
+  } );
+
+  afterFlushWriteBuffer();
+}
+
+void rocksdb_ah_storage_provider::waitForPendingWrite()
+{
+  if( !_pendingWriteResult.valid() )
+    return;
+
+  auto s = _pendingWriteResult.get();
+  _pendingWrite.Clear();
+  _writeBuffer.releaseDetached();
+  checkStatus(s);
+}
+
+void rocksdb_ah_storage_provider::setBulkImportMode( bool enable )
+{
+  if( !enable )
+    waitForPendingWrite();
+  _bulkImport = enable;
 }
 
 ColumnFamilyHandle* rocksdb_ah_storage_provider::getColumnHandle( Columns column )
@@ -125,6 +166,7 @@ void rocksdb_ah_storage_provider::openDb( uint32_t expected_lib )
 
 void rocksdb_ah_storage_provider::shutdownDb()
 {
+  waitForPendingWrite();
   rocksdb_storage_provider::shutdownDb();
 }
 
@@ -35,18 +35,37 @@ class account_history_api_rocksdb_impl : public abstract_account_history_api_imp
     const account_history_rocksdb::account_history_rocksdb_plugin& _dataSource;
 };
 
+/// Evaluates `check` once for (default constructed) operation of each type. Suitable only for checks depending on
+/// operation type alone, but allows data source to skip rejected operations without loading them.
+template< typename Check >
+account_history_rocksdb::operation_type_filter build_operation_type_filter( Check check )
+{
+  std::vector<bool> accepted( hive::protocol::operation::count() );
+  for( int64_t type = 0; type < hive::protocol::operation::count(); ++type )
+    accepted[ type ] = check( hive::protocol::operation( type ) );
+
+  return [ accepted = std::move( accepted ) ]( int64_t type ) -> bool
+  {
+    return type < static_cast< int64_t >( accepted.size() ) && accepted[ type ];
+  };
+}
+
 DEFINE_API_IMPL( account_history_api_rocksdb_impl, get_ops_in_block )
 {
   get_ops_in_block_return result;
 
   bool include_reversible = args.include_reversible.valid() ? *args.include_reversible : false;
+  static const account_history_rocksdb::operation_type_filter only_virtual_filter = build_operation_type_filter(
+    []( const hive::protocol::operation& op ) { return is_virtual_operation( op ); } );
+
   _dataSource.find_operations_by_block(args.block_num, include_reversible,
     [&result, &args](const account_history_rocksdb::rocksdb_operation_object& op)
     {
       api_operation_object temp(op);
       if( !args.only_virtual || is_virtual_operation( temp.op ) )
         result.ops.emplace(std::move(temp));
-    }
+    },
+    args.only_virtual ? only_virtual_filter : account_history_rocksdb::operation_type_filter()
   );
   return result;
 }
@@ -279,6 +298,16 @@ DEFINE_API_IMPL( account_history_api_rocksdb_impl, enum_virtual_ops)
   FC_ASSERT( limit > 0, "limit of ${l} is lesser or equal 0", ("l",limit) );
   FC_ASSERT( limit <= max_limit, "limit of ${l} is greater than maxmimum allowed", ("l",limit) );
 
+  account_history_rocksdb::operation_type_filter accept_op_type;
+  if( args.filter.valid() )
+  {
+    accept_op_type = build_operation_type_filter( [&args]( const hive::protocol::operation& op )
+    {
+      virtual_operation_filtering_visitor accepting_visitor;
+      return accepting_visitor.check( *args.filter, op );
+    } );
+  }
+
   std::pair< uint32_t, uint64_t > next_values = _dataSource.enum_operations_from_block_range(args.block_range_begin,
     args.block_range_end, include_reversible, args.operation_begin, limit,
     [groupOps, &result, &args ](const account_history_rocksdb::rocksdb_operation_object& op, uint64_t operation_id, bool irreversible)
@@ -336,7 +365,8 @@ DEFINE_API_IMPL( account_history_api_rocksdb_impl, enum_virtual_ops)
         }
         return true;
       }
-    }
+    },
+    accept_op_type
   );
 
   result.next_block_range_begin = next_values.first;
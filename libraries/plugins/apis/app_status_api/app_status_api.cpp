@@ -42,7 +42,10 @@ namespace detail
         hive::utilities::disconnect_signal( _on_new_fork_connection );
       }
 
-      DECLARE_API_IMPL((get_app_status))
+      DECLARE_API_IMPL(
+        (get_app_status)
+        (get_latency_stats)
+      )
   };
 
   DEFINE_API_IMPL(app_status_api_impl, get_app_status)
@@ -50,6 +53,11 @@ namespace detail
     std::unique_lock<std::shared_mutex> guard{app_status.read_mtx};
     return app_status.data;
   }
+
+  DEFINE_API_IMPL(app_status_api_impl, get_latency_stats)
+  {
+    return { hive::utilities::latency_stats::instance().get_summaries() };
+  }
 } // detail
 
 app_status_api::app_status_api( appbase::application& app ) : my(new detail::app_status_api_impl( app ))
@@ -59,6 +67,9 @@ app_status_api::app_status_api( appbase::application& app ) : my(new detail::app
 
 app_status_api::~app_status_api() {}
 
-DEFINE_LOCKLESS_APIS(app_status_api, (get_app_status))
+DEFINE_LOCKLESS_APIS(app_status_api,
+  (get_app_status)
+  (get_latency_stats)
+)
 
 } } } // hive::plugins::app_status_api
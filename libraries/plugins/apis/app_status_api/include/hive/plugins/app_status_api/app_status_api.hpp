@@ -4,6 +4,8 @@
 
 #include <hive/plugins/json_rpc/utility.hpp>
 
+#include <hive/utilities/latency_histogram.hpp>
+
 #include <fc/time.hpp>
 
 namespace hive { namespace plugins { namespace app_status_api {
@@ -14,6 +16,13 @@ using hive::plugins::json_rpc::void_type;
 typedef void_type get_app_status_args;
 using get_app_status_return = hive::utilities::statuses;
 
+/* get_latency_stats */
+typedef void_type get_latency_stats_args;
+struct get_latency_stats_return
+{
+  std::vector< hive::utilities::latency_stats::summary > stats;
+};
+
 namespace detail{ class app_status_api_impl; }
 
 class app_status_api
@@ -22,10 +31,15 @@ class app_status_api
     app_status_api( appbase::application& app );
     ~app_status_api();
 
-    DECLARE_API((get_app_status))
+    DECLARE_API(
+      (get_app_status)
+      (get_latency_stats)
+    )
 
   private:
     std::unique_ptr<detail::app_status_api_impl> my;
 };
 
 } } } // hive::plugins::app_status_api
+
+FC_REFLECT( hive::plugins::app_status_api::get_latency_stats_return, (stats) )
@@ -872,6 +872,7 @@ void chain_plugin_impl::initial_settings()
   bl_open_args.data_dir = db_open_args.data_dir;
   bl_open_args.enable_block_log_compression = enable_block_log_compression;
   bl_open_args.enable_block_log_auto_fixing = enable_block_log_auto_fixing;
+  bl_open_args.cache_recent_blocks = true; // peers and API calls ask for the same recent blocks
   bl_open_args.block_log_compression_level = block_log_compression_level;
   bl_open_args.load_snapshot = load_snapshot;
   bl_open_args.replay = replay;
@@ -1792,6 +1793,7 @@ void chain_plugin::plugin_initialize(const variables_map& options)
 #endif
   uint32_t blockchain_thread_pool_size = options.at("blockchain-thread-pool-size").as<uint32_t>();
   get_thread_pool().set_thread_pool_size(blockchain_thread_pool_size);
+  my->db.set_worker_thread_pool( &get_thread_pool() );
 
   if (my->validate_during_replay)
     get_thread_pool().set_validate_during_replay();
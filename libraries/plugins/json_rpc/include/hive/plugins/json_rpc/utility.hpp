@@ -47,7 +47,8 @@ BOOST_PP_CAT( method, _return ) class :: method ( const BOOST_PP_CAT( method, _a
 {                                                                                                        \
   if( lock )                                                                                            \
   {                                                                                                     \
-    return my->_db.with_read_lock( [&args, this](){ return my->method( args ); }, fc::seconds(1));      \
+    return my->_db.with_read_lock( [&args, this](){ return my->method( args ); }, fc::seconds(1),       \
+                                   BOOST_PP_STRINGIZE( method ) );                                      \
   }                                                                                                     \
   else                                                                                                  \
   {                                                                                                     \
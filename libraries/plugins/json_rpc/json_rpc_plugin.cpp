@@ -6,15 +6,22 @@
 #include <hive/protocol/misc_utilities.hpp>
 
 #include <boost/algorithm/string.hpp>
+#include <boost/asio/io_service.hpp>
 #include <boost/scope_exit.hpp>
 
 #include <fc/log/logger_config.hpp>
 #include <fc/exception/exception.hpp>
 #include <fc/macros.hpp>
 #include <fc/io/fstream.hpp>
+#include <fc/thread/thread.hpp>
 
 #include <chainbase/chainbase.hpp>
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
 #define ENABLE_JSON_RPC_LOG
 
 namespace hive { namespace plugins { namespace json_rpc {
@@ -249,8 +256,11 @@ namespace detail
       void rpc_id( const fc::variant_object& request, json_rpc_response& response );
       bool rpc_jsonrpc( const fc::variant_object& request, json_rpc_response& response );
       json_rpc_response rpc( const fc::variant& message );
+      vector< json_rpc_response > rpc_batch( const vector< fc::variant >& messages );
 
       void initialize();
+      void start_batch_threads( uint32_t thread_count );
+      void stop_batch_threads();
 
       void log(const fc::variant_object& request, json_rpc_response& response)
       {
@@ -264,12 +274,48 @@ namespace detail
 
       std::unique_ptr< json_rpc_logger >                 _logger;
 
+      /**
+        * Elements of a batch request are executed in parallel on these threads (and on the thread that received
+        * the batch), so one expensive call inside a batch does not hold back the cheap ones behind it.
+        */
+      boost::asio::io_service                            _batch_ios;
+      std::unique_ptr< boost::asio::io_service::work >   _batch_work;
+      std::vector< std::thread >                         _batch_threads;
+      // read by webserver threads calling rpc_batch, so they never look at _batch_threads itself
+      std::atomic< uint32_t >                            _batch_thread_count = { 0 };
+
       appbase::application& theApp;
   };
 
   json_rpc_plugin_impl::json_rpc_plugin_impl( appbase::application& app ): theApp( app ) {}
 
-  json_rpc_plugin_impl::~json_rpc_plugin_impl() {}
+  json_rpc_plugin_impl::~json_rpc_plugin_impl()
+  {
+    stop_batch_threads();
+  }
+
+  void json_rpc_plugin_impl::start_batch_threads( uint32_t thread_count )
+  {
+    if( thread_count == 0 )
+      return;
+
+    _batch_work.reset( new boost::asio::io_service::work( _batch_ios ) );
+    for( uint32_t i = 0; i < thread_count; ++i )
+      _batch_threads.emplace_back( [this]() { fc::set_thread_name( "api_batch" ); _batch_ios.run(); } );
+    _batch_thread_count = thread_count;
+  }
+
+  void json_rpc_plugin_impl::stop_batch_threads()
+  {
+    // batches arriving from now on are processed by their own thread; elements already posted to the helpers
+    // are taken by the thread that received the batch, so it completes even if the helpers never run them
+    _batch_thread_count = 0;
+    _batch_work.reset();
+    _batch_ios.stop();
+    for( auto& thread : _batch_threads )
+      if( thread.joinable() )
+        thread.join();
+  }
 
 
   void json_rpc_plugin_impl::add_api_method( const string& api_name, const string& method_name, const api_method& api, const api_method_signature& sig )
@@ -305,6 +351,7 @@ namespace detail
 
   void json_rpc_plugin_impl::plugin_pre_shutdown()
   {
+    stop_batch_threads();
     data._registered_apis.clear();
     data._methods.clear();
     data._method_sigs.clear();
@@ -586,6 +633,65 @@ namespace detail
 
     return response;
   }
+
+  vector< json_rpc_response > json_rpc_plugin_impl::rpc_batch( const vector< fc::variant >& messages )
+  {
+    vector< json_rpc_response > responses( messages.size() );
+
+    // the logger numbers its files in the order of calls, so keep batches sequential when it is enabled
+    const uint32_t batch_thread_count = _batch_thread_count;
+    if( batch_thread_count == 0 || _logger || messages.size() == 1 )
+    {
+      for( size_t i = 0; i < messages.size(); ++i )
+        responses[ i ] = rpc( messages[ i ] );
+      return responses;
+    }
+
+    // helpers may start only after the batch is complete, so everything they touch is kept alive by them
+    struct batch_state
+    {
+      batch_state( const vector< fc::variant >& _messages, vector< json_rpc_response >& _responses )
+        : messages( _messages ), responses( _responses ), element_count( _messages.size() ) {}
+
+      // only dereferenced for elements taken before the batch completed
+      const vector< fc::variant >&  messages;
+      vector< json_rpc_response >&  responses;
+      const size_t                  element_count;
+      std::atomic< size_t >         next_element = { 0 };
+      size_t                        completed_elements = 0;
+      std::mutex                    completed_mutex;
+      std::condition_variable       completed_condition;
+    };
+    auto state = std::make_shared< batch_state >( messages, responses );
+
+    auto process_elements = [this]( batch_state& state )
+    {
+      for( size_t i = state.next_element++; i < state.element_count; i = state.next_element++ )
+      {
+        state.responses[ i ] = rpc( state.messages[ i ] );
+        std::lock_guard< std::mutex > guard( state.completed_mutex );
+        if( ++state.completed_elements == state.element_count )
+          state.completed_condition.notify_one();
+      }
+    };
+
+    const size_t helper_count = std::min< size_t >( batch_thread_count, messages.size() - 1 );
+    const fc::time_point post_time = fc::time_point::now();
+    for( size_t i = 0; i < helper_count; ++i )
+    {
+      _batch_ios.post( [this, state, process_elements, post_time]()
+      {
+        STATSD_TIMER( "jsonrpc", "overhead", "batch_queue", fc::time_point::now() - post_time, 1.0f, theApp );
+        process_elements( *state );
+      } );
+    }
+
+    process_elements( *state );
+
+    std::unique_lock< std::mutex > lock( state->completed_mutex );
+    state->completed_condition.wait( lock, [&]() { return state->completed_elements == messages.size(); } );
+    return responses;
+  }
 }
 
 using detail::json_rpc_error;
@@ -599,6 +705,7 @@ void json_rpc_plugin::set_program_options( options_description& , options_descri
 {
   cfg.add_options()
     ("log-json-rpc", bpo::value< string >(), "json-rpc log directory name.")
+    ("rpc-batch-threads", bpo::value< uint32_t >()->default_value( 4 ), "Number of additional threads executing elements of json-rpc batch requests in parallel (0 executes them sequentially).")
     ;
 }
 
@@ -619,6 +726,8 @@ void json_rpc_plugin::plugin_initialize( const variables_map& options )
     fc::create_directories(p);
     my->_logger.reset(new json_rpc_logger(dir_name));
   }
+
+  my->start_batch_threads( options.at( "rpc-batch-threads" ).as< uint32_t >() );
 }
 
 void json_rpc_plugin::plugin_startup() {}
@@ -659,10 +768,7 @@ string json_rpc_plugin::call( const string& message )
 
       if( messages.size() )
       {
-        responses.reserve( messages.size() );
-
-        for( auto& m : messages )
-          responses.push_back( my->rpc( m ) );
+        responses = my->rpc_batch( messages );
 
         return fc::json::to_string( responses );
       }
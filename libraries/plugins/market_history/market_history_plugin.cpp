@@ -11,8 +11,15 @@
 
 #include <fc/io/json.hpp>
 
+#include <boost/preprocessor/stringize.hpp>
+
 #define MH_BUCKET_SIZE "market-history-bucket-size"
 #define MH_BUCKETS_PER_SIZE "market-history-buckets-per-size"
+#define MH_TRADE_HISTORY_DAYS "market-history-trade-history-days"
+
+// limit of expired trades removed per new trade; it is still more than one, so when the retention limit is first
+// enabled on a node with long history, the backlog is cleared over many blocks instead of in a single undo session
+#define MH_MAX_EXPIRED_TRADES_REMOVED_PER_FILL 100
 
 namespace hive { namespace plugins { namespace market_history {
 
@@ -37,6 +44,7 @@ class market_history_plugin_impl
     flat_set<uint32_t>            _tracked_buckets = flat_set<uint32_t>  { 15, 60, 300, 3600, 86400 };
     int32_t                       _maximum_history_per_bucket_size = 86400 / 15; // smallest buckets should
       // cover at least 24 hours, otherwise get_ticker/get_volume api calls won't work properly
+    uint32_t                      _trade_history_days = 0; // 0 means whole trade history is kept
     boost::signals2::connection   _post_apply_operation_conn;
 };
 
@@ -55,6 +63,23 @@ void market_history_plugin_impl::on_post_apply_operation( const operation_notifi
       ho.op = op;
     });
 
+    if( _trade_history_days )
+    {
+      // trades are created in time order, so the expired ones are always at the front of the index
+      const auto& history_idx = _db.get_index< order_history_index >().indices().get< by_time >();
+      auto trade_cutoff = _db.head_block_time() - fc::days( _trade_history_days );
+      auto history_itr = history_idx.begin();
+      uint32_t removed_trades = 0;
+      while( history_itr != history_idx.end() && history_itr->time < trade_cutoff &&
+        removed_trades < MH_MAX_EXPIRED_TRADES_REMOVED_PER_FILL )
+      {
+        const auto& old_trade = *history_itr;
+        ++history_itr;
+        _db.remove( old_trade );
+        ++removed_trades;
+      }
+    }
+
     if( !_maximum_history_per_bucket_size ) return;
     if( !_tracked_buckets.size() ) return;
 
@@ -167,6 +192,9 @@ void market_history_plugin::set_program_options(
         "Track market history by grouping orders into buckets of equal size measured in seconds specified as a JSON array of numbers")
       (MH_BUCKETS_PER_SIZE, boost::program_options::value<uint32_t>()->default_value(5760),
         "How far back in time to track history for each bucket size, measured in the number of buckets (default: 5760)")
+      (MH_TRADE_HISTORY_DAYS, boost::program_options::value<uint32_t>()->default_value(0),
+        "How many days of individual trades to keep for get_trade_history/get_recent_trades (default: 0 - keep whole history). "
+        "Expired trades are removed gradually, up to " BOOST_PP_STRINGIZE( MH_MAX_EXPIRED_TRADES_REMOVED_PER_FILL ) " with each new trade")
       ;
 }
 
@@ -196,6 +224,12 @@ void market_history_plugin::plugin_initialize( const boost::program_options::var
       state_opts[MH_BUCKETS_PER_SIZE] = my->_maximum_history_per_bucket_size;
     }
 
+    if( options.count( MH_TRADE_HISTORY_DAYS ) )
+    {
+      my->_trade_history_days = options[MH_TRADE_HISTORY_DAYS].as< uint32_t >();
+      state_opts[MH_TRADE_HISTORY_DAYS] = my->_trade_history_days;
+    }
+
     get_app().get_plugin< chain::chain_plugin >().report_state_options( name(), state_opts );
 
     ilog( "market_history: plugin_initialize() end" );
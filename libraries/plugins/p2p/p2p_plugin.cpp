@@ -126,6 +126,7 @@ public:
   string user_agent;
   fc::mutable_variant_object config;
   uint32_t max_connections = 0;
+  fc::optional<uint32_t> crypto_threads;
   bool force_validate = false;
   bool block_producer = false;
 
@@ -395,6 +396,7 @@ void p2p_plugin::set_program_options( bpo::options_description& cli, bpo::option
   cfg.add_options()
     ("p2p-endpoint", bpo::value<string>()->implicit_value("127.0.0.1:9876"), "The local IP address and port to listen for incoming connections.")
     ("p2p-max-connections", bpo::value<uint32_t>(), "Maxmimum number of incoming connections on P2P endpoint.")
+    ("p2p-crypto-threads", bpo::value<uint32_t>(), ("Number of threads encrypting and decrypting P2P traffic, 0 to do it on the P2P thread. (Default: " + std::to_string(GRAPHENE_NET_DEFAULT_STCP_CRYPTO_THREADS) + ")").c_str() )
     ("p2p-seed-node", bpo::value<vector<string>>()->composing()->default_value( default_seeds, seed_ss.str() ), "The IP address and port of a remote peer to sync with.")
     ("p2p-parameters", bpo::value<string>(), ("P2P network parameters. (Default: " + fc::json::to_string(graphene::net::node_configuration()) + " )").c_str() )
     ;
@@ -415,6 +417,9 @@ void p2p_plugin::plugin_initialize(const boost::program_options::variables_map&
   if( options.count( "p2p-max-connections" ) )
     my->max_connections = options.at( "p2p-max-connections" ).as< uint32_t >();
 
+  if( options.count( "p2p-crypto-threads" ) )
+    my->crypto_threads = options.at( "p2p-crypto-threads" ).as< uint32_t >();
+
   if (options.count("p2p-seed-node"))
   {
     vector<string> seeds;
@@ -498,6 +503,14 @@ void p2p_plugin::plugin_startup()
       my->config.set( "maximum_number_of_connections", fc::variant( my->max_connections ) );
     }
 
+    if( my->crypto_threads )
+    {
+      if( my->config.find( "stcp_crypto_threads" ) != my->config.end() )
+        ilog( "Overriding advanded_node_parameters[ \"stcp_crypto_threads\" ] with ${threads}", ("threads", *my->crypto_threads) );
+
+      my->config.set( "stcp_crypto_threads", fc::variant( *my->crypto_threads ) );
+    }
+
     ilog("Setting parameters");
     my->node->set_advanced_node_parameters( my->config );
 
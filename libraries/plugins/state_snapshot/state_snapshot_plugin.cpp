@@ -37,8 +37,12 @@
 #include <boost/algorithm/string.hpp>
 #include <boost/asio/io_service.hpp>
 #include <boost/thread/thread.hpp>
+#include <boost/scope_exit.hpp>
 
+#include <algorithm>
+#include <condition_variable>
 #include <limits>
+#include <mutex>
 #include <string>
 #include <typeindex>
 #include <typeinfo>
@@ -352,13 +356,44 @@ class snapshot_processor_data : public BaseClass
     bool _processingSuccess = false;
   };
 
+/// Number of threads allowed to work on the snapshot dump at once, shared by all indices dumped in parallel
+class dump_thread_budget final
+  {
+  public:
+    explicit dump_thread_budget(size_t threads) : _available(threads) {}
+
+    dump_thread_budget(const dump_thread_budget&) = delete;
+    dump_thread_budget& operator=(const dump_thread_budget&) = delete;
+
+    void acquire(size_t threads)
+      {
+      std::unique_lock<std::mutex> lock(_mutex);
+      _released.wait(lock, [&]() { return _available >= threads; });
+      _available -= threads;
+      }
+
+    void release(size_t threads)
+      {
+        {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _available += threads;
+        }
+      _released.notify_all();
+      }
+
+  private:
+    std::mutex _mutex;
+    std::condition_variable _released;
+    size_t _available;
+  };
+
 class index_dump_writer final : public snapshot_processor_data<chainbase::snapshot_writer>
   {
   public:
     index_dump_writer(const chain::database& mainDb, const chainbase::abstract_index& index, const bfs::path& outputRootPath,
-      bool allow_concurrency, const std::atomic_bool& is_error) :
+      size_t max_concurrency, const std::atomic_bool& is_error) :
       snapshot_processor_data<chainbase::snapshot_writer>(outputRootPath), _mainDb(mainDb), _index(index), _firstId(0), _lastId(0),
-      _nextId(0), _allow_concurrency(allow_concurrency), _is_error(is_error) {}
+      _nextId(0), _max_concurrency(max_concurrency), _is_error(is_error) {}
 
     index_dump_writer(const index_dump_writer&) = delete;
     index_dump_writer& operator=(const index_dump_writer&) = delete;
@@ -383,7 +418,7 @@ class index_dump_writer final : public snapshot_processor_data<chainbase::snapsh
     size_t _firstId;
     size_t _lastId;
     size_t _nextId;
-    bool   _allow_concurrency;
+    size_t _max_concurrency; /// limit of threads used to dump ranges of single index (including the calling one)
     const std::atomic_bool& _is_error;
   };
 
@@ -613,7 +648,7 @@ void index_dump_writer::start(const workers& workers)
   {
   FC_ASSERT(_builtWorkers.size() == workers.size());
 
-  const size_t num_threads = _allow_concurrency ? std::min(workers.size(), static_cast<size_t>(16)) : 1;
+  const size_t num_threads = std::max<size_t>(std::min(workers.size(), _max_concurrency), 1);
 
   if(num_threads > 1)
     {
@@ -621,7 +656,8 @@ void index_dump_writer::start(const workers& workers)
     boost::thread_group threadpool;
     std::unique_ptr<boost::asio::io_service::work> work = std::make_unique<boost::asio::io_service::work>(ioService);
 
-    for(unsigned int i = 0; i < num_threads; ++i)
+    /// The calling thread is one of the workers, so the index uses exactly the number of threads granted to it
+    for(unsigned int i = 1; i < num_threads; ++i)
       threadpool.create_thread(boost::bind(&boost::asio::io_service::run, &ioService));
 
     for(size_t i = 0; i < _builtWorkers.size(); ++i)
@@ -637,6 +673,16 @@ void index_dump_writer::start(const workers& workers)
     /// Run the horses...
     work.reset();
 
+    try
+      {
+      ioService.run();
+      }
+    catch(...)
+      {
+      threadpool.join_all();
+      throw;
+      }
+
     threadpool.join_all();
     }
   else
@@ -1488,12 +1534,33 @@ void state_snapshot_plugin::impl::prepare_snapshot(const std::string& snapshotNa
     for(unsigned int i = 0; i < _num_threads; ++i)
       threadpool.create_thread(boost::bind(&boost::asio::io_service::run, &ioService));
 
+    /// All indices share one budget of _num_threads working threads: each index gets a share proportional to its size
+    /// (at least one thread) and waits until that many are free, so big indices are split into ranges without
+    /// multiplying the thread count by the number of indices dumped in parallel
+    size_t total_size = 0;
+    for(const chainbase::abstract_index* idx : indices)
+      total_size += idx->size();
+
+    dump_thread_budget budget(_num_threads);
+    std::vector<std::tuple<const chainbase::abstract_index*, index_dump_writer*, size_t>> jobs;
     for(const chainbase::abstract_index* idx : indices)
     {
-      builtWriters.emplace_back(std::make_unique<index_dump_writer>(_mainDb, *idx, actualStoragePath, true /* allow_concurrency */, _is_error));
-      index_dump_writer* writer = builtWriters.back().get();
-      ioService.post(boost::bind(&impl::safe_spawn_snapshot_dump, this, idx, writer));
+      size_t threads = total_size ? static_cast<size_t>(static_cast<double>(_num_threads) * idx->size() / total_size) : 1;
+      threads = std::clamp<size_t>(threads, 1, _num_threads);
+      builtWriters.emplace_back(std::make_unique<index_dump_writer>(_mainDb, *idx, actualStoragePath, threads, _is_error));
+      jobs.emplace_back(idx, builtWriters.back().get(), threads);
     }
+
+    /// Start with biggest indices, so the longest dumps don't end up being started last and keep the node waiting for them
+    std::stable_sort(jobs.begin(), jobs.end(), [](const auto& a, const auto& b) { return std::get<0>(a)->size() > std::get<0>(b)->size(); });
+    for(const auto& job : jobs)
+      ioService.post([this, &budget, job]()
+        {
+        const size_t threads = std::get<2>(job);
+        budget.acquire(threads);
+        BOOST_SCOPE_EXIT(&budget, threads) { budget.release(threads); } BOOST_SCOPE_EXIT_END
+        safe_spawn_snapshot_dump(std::get<0>(job), std::get<1>(job));
+        });
     ilog("Waiting for dumping jobs completion");
     work.reset();
     threadpool.join_all();
@@ -1507,7 +1574,7 @@ void state_snapshot_plugin::impl::prepare_snapshot(const std::string& snapshotNa
   {
     for(const chainbase::abstract_index* idx : indices)
     {
-      builtWriters.emplace_back(std::make_unique<index_dump_writer>(_mainDb, *idx, actualStoragePath, false /* allow_concurrency */, _is_error));
+      builtWriters.emplace_back(std::make_unique<index_dump_writer>(_mainDb, *idx, actualStoragePath, 1 /* max_concurrency */, _is_error));
       index_dump_writer* writer = builtWriters.back().get();
       safe_spawn_snapshot_dump(idx, writer);
     }
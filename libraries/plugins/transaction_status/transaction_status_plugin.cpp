@@ -67,8 +67,14 @@ void transaction_status_impl::on_post_apply_transaction( const transaction_notif
     _db.create< transaction_status_object >( [&]( transaction_status_object& obj )
     {
       obj.transaction_id = note.transaction_id;
-      // don't assign rc_cost because currently we can't be sure the RC signal is going to be handled prior to tx status signal
-      // (ABW: can be changed once RC is moved to consensus code, even if it remains non-consensus)
+      // when the transaction is applied as part of a block we already know everything about it (RC cost is
+      // finalized before the signal), so on_post_apply_block won't have to modify the object again; note that
+      // transactions are applied before the block becomes head block
+      if( _db.is_processing_block() )
+      {
+        obj.block_num = _db.head_block_num() + 1;
+        obj.rc_cost = note.full_transaction->get_rc_cost();
+      }
     } );
   }
 }
@@ -99,6 +105,10 @@ void transaction_status_impl::on_post_apply_block( const block_notification& not
     {
       const auto& tx_status_obj = _db.get< transaction_status_object, by_trx_id >( e->get_transaction_id() );
 
+      // usually filled already in on_post_apply_transaction, avoid needless undo state in such case
+      if( tx_status_obj.block_num == note.block_num && tx_status_obj.rc_cost == e->get_rc_cost() )
+        continue;
+
       _db.modify( tx_status_obj, [&] ( transaction_status_object& obj )
       {
         obj.block_num = note.block_num;
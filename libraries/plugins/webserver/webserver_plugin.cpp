@@ -3,6 +3,8 @@
 
 #include <hive/plugins/json_rpc/utility.hpp>
 
+#include <hive/utilities/latency_histogram.hpp>
+
 #include <fc/network/ip.hpp>
 #include <fc/log/logger_config.hpp>
 #include <fc/io/json.hpp>
@@ -258,6 +260,8 @@ class webserver_base
     optional< tcp::endpoint >                                 http_endpoint;
     optional< boost::asio::local::stream_protocol::endpoint > unix_endpoint;
     optional< tcp::endpoint >                                 ws_endpoint;
+
+    bool                                                      metrics_enabled = false;
 };
 
 template<typename websocket_server_type>
@@ -617,8 +621,16 @@ void webserver_plugin_impl<websocket_server_type>::handle_http_message( websocke
 
     try
     {
-      con->set_body( api->call( body ) );
-      con->append_header( "Content-Type", "application/json" );
+      if( metrics_enabled && con->get_request().get_method() == "GET" && con->get_resource() == "/metrics" )
+      {
+        con->set_body( hive::utilities::latency_stats::instance().to_prometheus_text() );
+        con->append_header( "Content-Type", "text/plain; version=0.0.4" );
+      }
+      else
+      {
+        con->set_body( api->call( body ) );
+        con->append_header( "Content-Type", "application/json" );
+      }
 
       /*
         HTTP/1.1 applications that do not support persistent connections MUST include the "close" connection option in every message. 
@@ -734,6 +746,7 @@ void webserver_plugin::set_program_options( options_description&, options_descri
     ("webserver-ws-endpoint", bpo::value< string >(), "Local websocket endpoint for webserver requests.")
     // TODO: maybe add a flag to make this optional
     ("webserver-ws-deflate", bpo::value<bool>()->default_value( false ), "Enable the RFC-7692 permessage-deflate extension for the WebSocket server (only used if the client requests it).  This may save bandwidth at the expense of CPU")
+    ("webserver-enable-metrics", bpo::value<bool>()->default_value( false ), "Serve latency statistics in Prometheus text format on `GET /metrics` of the http/https endpoint. Anyone who can reach that endpoint can read them.")
     ("webserver-thread-pool-size", bpo::value<thread_pool_size_t>()->default_value(16),
       "Number of threads used to handle queries. Default: 16.")
     ("webserver-https-certificate-file-name", bpo::value< string >(), "File name with a server's certificate." )
@@ -779,6 +792,10 @@ void webserver_plugin::plugin_initialize( const variables_map& options )
       my.reset( new detail::webserver_plugin_impl<detail::websocket_server_type_nondeflate>( thread_pool_size, get_app() ) );
   }
 
+  my->metrics_enabled = options.at( "webserver-enable-metrics" ).as< bool >();
+  if( my->metrics_enabled )
+    ilog( "Latency metrics will be served on GET /metrics" );
+
   if( options.count( "webserver-http-endpoint" ) || options.count( "webserver-https-endpoint" ) )
   {
     std::string _http_or_https_endpoint = my->tls ? options.at( "webserver-https-endpoint" ).as< string >() : options.at( "webserver-http-endpoint" ).as< string >();
@@ -16,12 +16,18 @@ struct sign_limits
   uint32_t account_auths = ~0;
 };
 
-template <bool IS_TRACED=false>
+/**
+ * AUTHORITY_GETTER is either authority_getter (authorities are copied) or authority_ref_getter
+ * (authorities are used in place, f.e. straight from a cache); tracing requires the former.
+ */
+template <bool IS_TRACED=false, typename AUTHORITY_GETTER=authority_getter>
 class sign_state
 {
+    static_assert( !IS_TRACED || std::is_same_v<AUTHORITY_GETTER, authority_getter>, "tracing requires authority_getter" );
+
     size_t account_auth_count       = 0;
 
-    authority_getter                get_current_authority;
+    AUTHORITY_GETTER                get_current_authority;
 
     const sign_limits               limits;
     flat_set<string>                approved_by;
@@ -35,7 +41,7 @@ class sign_state
      * @param the_tracer mandatory when IS_TRACED, ignored otherwise
      */
     sign_state( const flat_set<public_key_type>& sigs,
-      const authority_getter& getter,
+      const AUTHORITY_GETTER& getter,
       const sign_limits& limits,
       authority_verification_tracer* the_tracer = nullptr )
       : get_current_authority( getter ), limits( limits ), tracer(the_tracer)
@@ -58,8 +64,8 @@ class sign_state
 
     bool check_authority( const string& id )
     {
-      authority initial_auth;
       if constexpr (IS_TRACED) {
+        authority initial_auth;
         FC_ASSERT(tracer && "check_authority 1");
         try
         {
@@ -71,34 +77,10 @@ class sign_state
         }           
 
         tracer->on_root_authority_start(id, initial_auth.weight_threshold, 0);
+        return check_root_authority( initial_auth, id );
       }
       else
-        initial_auth = get_current_authority( id );
-
-      if( approved_by.find(id) != approved_by.end() )
-      {
-        if constexpr (IS_TRACED) {
-          FC_ASSERT(tracer && "check_authority 2");
-          tracer->on_approved_authority( id, initial_auth.weight_threshold );
-        }
-
-        return true;
-      }
-
-      if( limits.allow_strict_and_mixed_authorities )
-        ++account_auth_count;
-      else
-        account_auth_count = 1;
-
-      bool success = check_authority_impl( initial_auth, 0 );
-
-      if constexpr (IS_TRACED) {
-          FC_ASSERT(tracer && "check_authority 3");
-          // TODO: Provide appropriate set of flags.
-          tracer->on_root_authority_finish(success, 0);
-      }
-
-      return success;
+        return check_root_authority( get_current_authority( id ), id );
     }
 
     /**
@@ -157,13 +139,41 @@ class sign_state
 
     const flat_map<public_key_type,bool>&  get_provided_signatures() const { return provided_signatures; }
 
-    void change_current_authority( const authority_getter& a )
+    void change_current_authority( const AUTHORITY_GETTER& a )
     {
       get_current_authority = a;
     }
 
   private:
 
+    bool check_root_authority( const authority& initial_auth, const string& id )
+    {
+      if( approved_by.find(id) != approved_by.end() )
+      {
+        if constexpr (IS_TRACED) {
+          FC_ASSERT(tracer && "check_authority 2");
+          tracer->on_approved_authority( id, initial_auth.weight_threshold );
+        }
+
+        return true;
+      }
+
+      if( limits.allow_strict_and_mixed_authorities )
+        ++account_auth_count;
+      else
+        account_auth_count = 1;
+
+      bool success = check_authority_impl( initial_auth, 0 );
+
+      if constexpr (IS_TRACED) {
+          FC_ASSERT(tracer && "check_authority 3");
+          // TODO: Provide appropriate set of flags.
+          tracer->on_root_authority_finish(success, 0);
+      }
+
+      return success;
+    }
+
     bool check_authority_impl( const authority& auth, uint32_t depth )
     {
       uint32_t total_weight = 0;
@@ -235,8 +245,9 @@ class sign_state
 
           ++account_auth_count;
 
-          authority account_auth;
+          bool success = false;
           if constexpr (IS_TRACED) {
+            authority account_auth;
             FC_ASSERT(tracer && "check_authority 11");
             try
             {
@@ -248,11 +259,10 @@ class sign_state
             }           
 
             tracer->on_entering_account_entry( a.first, a.second, account_auth.weight_threshold, depth );
+            success = check_authority_impl( account_auth, depth + 1 );
           }
           else
-            account_auth = get_current_authority( a.first );
-
-          bool success = check_authority_impl( account_auth, depth + 1 );
+            success = check_authority_impl( get_current_authority( a.first ), depth + 1 );
           if( success )
           {
             approved_by.insert( a.first );
@@ -6,6 +6,8 @@
 namespace hive { namespace protocol {
 
 typedef std::function<authority(const string&)> authority_getter;
+/// returned authority has to stay valid and unchanged until verification ends (f.e. it is held in a cache)
+typedef std::function<const authority&(const string&)> authority_ref_getter;
 typedef std::function<public_key_type(const string&)> witness_public_key_getter;
 
 struct required_authorities_type
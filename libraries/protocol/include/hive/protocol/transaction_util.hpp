@@ -85,6 +85,27 @@ class authority_getter_i {
   virtual std::optional<public_key_type> get_witness_key(const string&) const = 0;
 };
 
+/**
+ * Source of authorities that are verified in place instead of being copied for every account visited.
+ * Returned references have to stay valid and unchanged until verification ends.
+ */
+class authority_ref_getter_i {
+  public:
+  virtual const authority& get_active(const string&) = 0;
+  virtual const authority& get_owner(const string&) = 0;
+  virtual const authority& get_posting(const string&) = 0;
+};
+
+void verify_authority(bool allow_strict_and_mixed_authorities,
+                      bool allow_redundant_signatures,
+                      const required_authorities_type& required_authorities,
+                      const flat_set<public_key_type>& sigs,
+                      authority_ref_getter_i& getters,
+                      const witness_public_key_getter& get_witness_key,
+                      uint32_t max_recursion_depth = HIVE_MAX_SIG_CHECK_DEPTH,
+                      uint32_t max_membership = HIVE_MAX_AUTHORITY_MEMBERSHIP,
+                      uint32_t max_account_auths = HIVE_MAX_SIG_CHECK_ACCOUNTS);
+
 authority_verification_trace verify_authority_with_tracing(
   bool allow_strict_and_mixed_authorities,
   bool allow_redundant_signatures,
@@ -13,15 +13,16 @@ enum class verify_authority_problem
   unused_signature
 };
 
-template< bool IS_TRACED=false, typename PROBLEM_HANDLER, typename OTHER_AUTH_PROBLEM_HANDLER >
+// AUTHORITY_GETTER has to be given explicitly (authority_getter or authority_ref_getter), callers pass lambdas
+template< bool IS_TRACED, typename AUTHORITY_GETTER, typename PROBLEM_HANDLER, typename OTHER_AUTH_PROBLEM_HANDLER >
 void verify_authority_impl(
   bool allow_strict_and_mixed_authorities,
   bool allow_redundant_signatures,
   const required_authorities_type& required_authorities,
   const flat_set<public_key_type>& sigs,
-  const authority_getter& get_active,
-  const authority_getter& get_owner,
-  const authority_getter& get_posting,
+  const AUTHORITY_GETTER& get_active,
+  const AUTHORITY_GETTER& get_owner,
+  const AUTHORITY_GETTER& get_posting,
   const witness_public_key_getter& get_witness_key,
   uint32_t max_recursion_depth,
   uint32_t max_membership,
@@ -53,7 +54,7 @@ FC_EXPAND_MACRO(                                                \
   FC_MULTILINE_MACRO_END                                        \
 )
 
-  sign_state<IS_TRACED> s( sigs, get_posting, { allow_strict_and_mixed_authorities, max_recursion_depth, max_membership, max_account_auths }, tracer );
+  sign_state<IS_TRACED, AUTHORITY_GETTER> s( sigs, get_posting, { allow_strict_and_mixed_authorities, max_recursion_depth, max_membership, max_account_auths }, tracer );
 
   if( not required_authorities.required_posting.empty() )
   {
@@ -190,14 +191,14 @@ FC_EXPAND_MACRO(                                                \
 #undef VERIFY_AUTHORITY_CHECK_OTHER_AUTH
 }
 
-template<bool IS_TRACED>
+template<bool IS_TRACED, typename AUTHORITY_GETTER>
 void verify_authority(bool allow_strict_and_mixed_authorities,
                       bool allow_redundant_signatures,
                       const required_authorities_type& required_authorities,
                       const flat_set<public_key_type>& sigs,
-                      const authority_getter& get_active,
-                      const authority_getter& get_owner,
-                      const authority_getter& get_posting,
+                      const AUTHORITY_GETTER& get_active,
+                      const AUTHORITY_GETTER& get_owner,
+                      const AUTHORITY_GETTER& get_posting,
                       const witness_public_key_getter& get_witness_key,
                       uint32_t max_recursion_depth /* = HIVE_MAX_SIG_CHECK_DEPTH */,
                       uint32_t max_membership /* = HIVE_MAX_AUTHORITY_MEMBERSHIP */,
@@ -209,7 +210,7 @@ void verify_authority(bool allow_strict_and_mixed_authorities,
                       authority_verification_tracer* tracer
 )
 { try {
-  verify_authority_impl<IS_TRACED>( allow_strict_and_mixed_authorities, allow_redundant_signatures, required_authorities, sigs,
+  verify_authority_impl<IS_TRACED, AUTHORITY_GETTER>( allow_strict_and_mixed_authorities, allow_redundant_signatures, required_authorities, sigs,
     get_active, get_owner, get_posting, get_witness_key,
     max_recursion_depth, max_membership, max_account_auths,
     active_approvals, owner_approvals, posting_approvals,
@@ -280,7 +281,7 @@ void verify_authority(bool allow_strict_and_mixed_authorities,
                       const flat_set<account_name_type>& posting_approvals /* = flat_set<account_name_type>() */
                       )
 {
-  verify_authority<false>(
+  verify_authority<false, authority_getter>(
     allow_strict_and_mixed_authorities,
     allow_redundant_signatures,
     required_authorities,
@@ -300,6 +301,37 @@ void verify_authority(bool allow_strict_and_mixed_authorities,
   );
 }
 
+void verify_authority(bool allow_strict_and_mixed_authorities,
+                      bool allow_redundant_signatures,
+                      const required_authorities_type& required_authorities,
+                      const flat_set<public_key_type>& sigs,
+                      authority_ref_getter_i& getters,
+                      const witness_public_key_getter& get_witness_key,
+                      uint32_t max_recursion_depth /* = HIVE_MAX_SIG_CHECK_DEPTH */,
+                      uint32_t max_membership /* = HIVE_MAX_AUTHORITY_MEMBERSHIP */,
+                      uint32_t max_account_auths /* = HIVE_MAX_SIG_CHECK_ACCOUNTS */
+                      )
+{
+  verify_authority<false, authority_ref_getter>(
+    allow_strict_and_mixed_authorities,
+    allow_redundant_signatures,
+    required_authorities,
+    sigs,
+    [&](const string& id) -> const authority& { return getters.get_active(id); },
+    [&](const string& id) -> const authority& { return getters.get_owner(id); },
+    [&](const string& id) -> const authority& { return getters.get_posting(id); },
+    get_witness_key,
+    max_recursion_depth,
+    max_membership,
+    max_account_auths,
+    false,
+    flat_set<account_name_type>(),
+    flat_set<account_name_type>(),
+    flat_set<account_name_type>(),
+    nullptr
+  );
+}
+
 template <class T>
 T force_found(std::optional<T> t, const string& id)
 {
@@ -325,7 +357,7 @@ authority_verification_trace verify_authority_with_tracing(
   )
 {
   authority_verification_tracer tracer;
-  verify_authority_impl<true>(
+  verify_authority_impl<true, authority_getter>(
     allow_strict_and_mixed_authorities,
     allow_redundant_signatures,
     required_authorities,
@@ -361,7 +393,7 @@ bool has_authorization( bool allow_strict_and_mixed_authorities,
   const witness_public_key_getter& get_witness_key )
 {
   bool result = true;
-  verify_authority_impl<false>( allow_strict_and_mixed_authorities, allow_redundant_signatures, required_authorities, sigs,
+  verify_authority_impl<false, authority_getter>( allow_strict_and_mixed_authorities, allow_redundant_signatures, required_authorities, sigs,
     get_active, get_owner, get_posting, get_witness_key,
     HIVE_MAX_SIG_CHECK_DEPTH, HIVE_MAX_AUTHORITY_MEMBERSHIP, HIVE_MAX_SIG_CHECK_ACCOUNTS,
     flat_set<account_name_type>(), flat_set<account_name_type>(), flat_set<account_name_type>(),
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <fc/reflect/reflect.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace hive { namespace utilities {
+
+/**
+  * Fixed size latency histogram with log-linear buckets (HDR-style): every power of two is split into
+  * 8 linear sub-buckets, so recorded values keep ~12% precision from nanoseconds up to over a minute.
+  * Recording is a handful of relaxed atomic increments, which makes it cheap enough to stay always on.
+  */
+class latency_histogram
+{
+  public:
+    static constexpr uint32_t sub_bucket_bits = 3;
+    static constexpr uint32_t sub_bucket_count = 1 << sub_bucket_bits;
+    static constexpr uint32_t max_value_bits = 36; // ~68s, longer measurements land in the last bucket
+    static constexpr uint32_t bucket_count = ( max_value_bits - sub_bucket_bits + 1 ) * sub_bucket_count;
+
+    struct snapshot
+    {
+      uint64_t count = 0;
+      uint64_t total_ns = 0;
+      uint64_t max_ns = 0;
+      std::vector<uint64_t> buckets;
+
+      /// upper bound of the bucket containing given percentile (0-100] of recorded values
+      uint64_t percentile( double p ) const;
+    };
+
+    void record( uint64_t ns );
+    snapshot take_snapshot() const;
+
+    static uint32_t bucket_index( uint64_t ns );
+    static uint64_t bucket_upper_bound( uint32_t index );
+
+  private:
+    std::array< std::atomic<uint64_t>, bucket_count > _buckets = {};
+    std::atomic<uint64_t> _count = { 0 };
+    std::atomic<uint64_t> _total_ns = { 0 };
+    std::atomic<uint64_t> _max_ns = { 0 };
+};
+
+/**
+  * Process wide registry of latency histograms identified by context (f.e. "evaluator", "pre->plugin_name")
+  * and item name. Histograms are never removed, so references returned by \see get stay valid and should be
+  * cached by the caller - lookup takes a lock, recording does not.
+  */
+class latency_stats
+{
+  public:
+    struct summary
+    {
+      std::string context;
+      std::string name;
+      uint64_t    count = 0;
+      uint64_t    total_ns = 0;
+      uint64_t    max_ns = 0;
+      uint64_t    p50_ns = 0;
+      uint64_t    p90_ns = 0;
+      uint64_t    p99_ns = 0;
+      uint64_t    p999_ns = 0;
+    };
+
+    static latency_stats& instance();
+
+    latency_histogram& get( const std::string& context, const std::string& name );
+
+    std::vector< summary > get_summaries() const;
+    /// Prometheus text exposition format (one summary metric with quantiles per histogram)
+    std::string to_prometheus_text() const;
+
+  private:
+    latency_stats() = default;
+
+    mutable std::mutex _mtx;
+    std::map< std::pair< std::string, std::string >, std::unique_ptr< latency_histogram > > _histograms;
+};
+
+/// Records time spent in its scope into given histogram (nothing when histogram is null).
+class scoped_latency_timer
+{
+  public:
+    explicit scoped_latency_timer( latency_histogram* histogram )
+      : _histogram( histogram )
+    {
+      if( _histogram != nullptr )
+        _start = std::chrono::steady_clock::now();
+    }
+
+    ~scoped_latency_timer()
+    {
+      if( _histogram != nullptr )
+        _histogram->record( std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now() - _start ).count() );
+    }
+
+    scoped_latency_timer( const scoped_latency_timer& ) = delete;
+    scoped_latency_timer& operator=( const scoped_latency_timer& ) = delete;
+
+  private:
+    latency_histogram* _histogram = nullptr;
+    std::chrono::steady_clock::time_point _start;
+};
+
+} } // hive::utilities
+
+FC_REFLECT( hive::utilities::latency_stats::summary, (context)(name)(count)(total_ns)(max_ns)(p50_ns)(p90_ns)(p99_ns)(p999_ns) )
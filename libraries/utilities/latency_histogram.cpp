@@ -0,0 +1,162 @@
+#include <hive/utilities/latency_histogram.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+namespace hive { namespace utilities {
+
+uint32_t latency_histogram::bucket_index( uint64_t ns )
+{
+  if( ns < sub_bucket_count )
+    return static_cast<uint32_t>( ns );
+  if( ns >= ( uint64_t( 1 ) << max_value_bits ) )
+    return bucket_count - 1;
+
+  uint32_t msb = 63 - __builtin_clzll( ns );
+  uint32_t shift = msb - sub_bucket_bits;
+  return ( shift + 1 ) * sub_bucket_count + static_cast<uint32_t>( ( ns >> shift ) & ( sub_bucket_count - 1 ) );
+}
+
+uint64_t latency_histogram::bucket_upper_bound( uint32_t index )
+{
+  if( index < sub_bucket_count )
+    return index;
+
+  uint32_t shift = index / sub_bucket_count - 1;
+  uint64_t sub_bucket = index % sub_bucket_count;
+  return ( ( sub_bucket_count + sub_bucket + 1 ) << shift ) - 1;
+}
+
+void latency_histogram::record( uint64_t ns )
+{
+  _buckets[ bucket_index( ns ) ].fetch_add( 1, std::memory_order_relaxed );
+  _count.fetch_add( 1, std::memory_order_relaxed );
+  _total_ns.fetch_add( ns, std::memory_order_relaxed );
+
+  uint64_t current_max = _max_ns.load( std::memory_order_relaxed );
+  while( ns > current_max && !_max_ns.compare_exchange_weak( current_max, ns, std::memory_order_relaxed ) );
+}
+
+latency_histogram::snapshot latency_histogram::take_snapshot() const
+{
+  snapshot result;
+  result.buckets.reserve( bucket_count );
+  // count is summed from buckets so percentiles stay consistent even when values are recorded concurrently
+  for( const auto& bucket : _buckets )
+  {
+    result.buckets.push_back( bucket.load( std::memory_order_relaxed ) );
+    result.count += result.buckets.back();
+  }
+  result.total_ns = _total_ns.load( std::memory_order_relaxed );
+  result.max_ns = _max_ns.load( std::memory_order_relaxed );
+  return result;
+}
+
+uint64_t latency_histogram::snapshot::percentile( double p ) const
+{
+  if( count == 0 )
+    return 0;
+
+  uint64_t target = static_cast<uint64_t>( std::ceil( p / 100.0 * count ) );
+  target = std::clamp<uint64_t>( target, 1, count );
+
+  uint64_t seen = 0;
+  for( uint32_t i = 0; i < buckets.size(); ++i )
+  {
+    seen += buckets[i];
+    if( seen >= target )
+      return std::min( bucket_upper_bound( i ), max_ns );
+  }
+  return max_ns;
+}
+
+latency_stats& latency_stats::instance()
+{
+  static latency_stats stats;
+  return stats;
+}
+
+latency_histogram& latency_stats::get( const std::string& context, const std::string& name )
+{
+  std::lock_guard<std::mutex> guard( _mtx );
+  auto& histogram = _histograms[ std::make_pair( context, name ) ];
+  if( !histogram )
+    histogram = std::make_unique<latency_histogram>();
+  return *histogram;
+}
+
+std::vector< latency_stats::summary > latency_stats::get_summaries() const
+{
+  std::vector< summary > result;
+
+  std::lock_guard<std::mutex> guard( _mtx );
+  result.reserve( _histograms.size() );
+  for( const auto& item : _histograms )
+  {
+    auto data = item.second->take_snapshot();
+    if( data.count == 0 )
+      continue;
+
+    summary s;
+    s.context = item.first.first;
+    s.name = item.first.second;
+    s.count = data.count;
+    s.total_ns = data.total_ns;
+    s.max_ns = data.max_ns;
+    s.p50_ns = data.percentile( 50 );
+    s.p90_ns = data.percentile( 90 );
+    s.p99_ns = data.percentile( 99 );
+    s.p999_ns = data.percentile( 99.9 );
+    result.emplace_back( std::move( s ) );
+  }
+  return result;
+}
+
+namespace {
+
+std::string escape_label_value( const std::string& value )
+{
+  std::string result;
+  result.reserve( value.size() );
+  for( char c : value )
+  {
+    switch( c )
+    {
+      case '\\': result += "\\\\"; break;
+      case '"':  result += "\\\""; break;
+      case '\n': result += "\\n"; break;
+      default:   result += c;
+    }
+  }
+  return result;
+}
+
+} // anonymous namespace
+
+std::string latency_stats::to_prometheus_text() const
+{
+  static const std::pair< const char*, double > quantiles[] = { { "0.5", 50 }, { "0.9", 90 }, { "0.99", 99 }, { "0.999", 99.9 } };
+  const char* metric = "hived_latency_seconds";
+
+  std::ostringstream out;
+  out << "# HELP " << metric << " Time spent in evaluators and plugin notification handlers.\n";
+  out << "# TYPE " << metric << " summary\n";
+
+  std::lock_guard<std::mutex> guard( _mtx );
+  for( const auto& item : _histograms )
+  {
+    auto data = item.second->take_snapshot();
+    if( data.count == 0 )
+      continue;
+
+    std::string labels = "context=\"" + escape_label_value( item.first.first ) + "\",name=\"" + escape_label_value( item.first.second ) + "\"";
+    for( const auto& q : quantiles )
+      out << metric << "{" << labels << ",quantile=\"" << q.first << "\"} " << data.percentile( q.second ) / 1e9 << "\n";
+    out << metric << "_sum{" << labels << "} " << data.total_ns / 1e9 << "\n";
+    out << metric << "_count{" << labels << "} " << data.count << "\n";
+  }
+  return out.str();
+}
+
+} } // hive::utilities
@@ -54,6 +54,7 @@ class beekeeper_api_impl
       (list_created_wallets)
       (get_public_keys)
       (sign_digest)
+      (sign_digests)
       (get_info)
       (create_session)
       (close_session)
@@ -189,6 +190,14 @@ DEFINE_API_IMPL( beekeeper_api_impl, sign_digest )
   return { _wallet_mgr->sign_digest( args.token, args.wallet_name, args.sig_digest, create( args.public_key ), prefix ) };
 }
 
+DEFINE_API_IMPL( beekeeper_api_impl, sign_digests )
+{
+  std::shared_lock guard( _mtx_handler->get_mutex() );
+
+  using namespace beekeeper;
+  return { _wallet_mgr->sign_digests( args.token, args.wallet_name, args.sig_digests, create( args.public_key ), prefix ) };
+}
+
 DEFINE_API_IMPL( beekeeper_api_impl, get_info )
 {
   std::shared_lock guard( _mtx_handler->get_mutex() );
@@ -279,6 +288,7 @@ DEFINE_LOCKLESS_APIS( beekeeper_wallet_api,
   (list_created_wallets)
   (get_public_keys)
   (sign_digest)
+  (sign_digests)
   (get_info)
   (create_session)
   (close_session)
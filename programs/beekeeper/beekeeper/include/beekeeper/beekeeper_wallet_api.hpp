@@ -45,6 +45,7 @@ class beekeeper_wallet_api
       (list_created_wallets)
       (get_public_keys)
       (sign_digest)
+      (sign_digests)
       (get_info)
       (create_session)
       (close_session)
@@ -51,6 +51,8 @@ export declare class BeekeeperInstanceHelper {
 
   public signDigest(sessionToken: string, sigDigest: string, publicKey: string): string;
 
+  public signDigests(sessionToken: string, sigDigests: StringList, publicKey: string): string[];
+
   public listWallets(sessionToken: string): { wallets: Array<{ name: string, unlocked: boolean }> };
 
   public getPublicKeys(sessionToken: string): { keys: Array<{ public_key: string }> };
@@ -272,6 +272,21 @@ export class BeekeeperInstanceHelper {
     }
   }
 
+  signDigests(sessionToken, sigDigests, publicKey) {
+    const returnedValue = this.instance.sign_digests(sessionToken, sigDigests, publicKey);
+
+    if( this.#acceptError )
+    {
+      return this.#extract(returnedValue);
+    }
+    else
+    {
+      const value = this.#extract(returnedValue);
+
+      return value.signatures;
+    }
+  }
+
   listWallets(sessionToken) {
     const returnedValue = this.instance.list_wallets(sessionToken);
 
@@ -72,6 +72,32 @@ test.describe('WASM beekeeper_api tests for Node.js', () => {
     expect(retVal.signDigest).toBe(retVal.expected);
   });
 
+  test('Should be able to sign a few digests at once', async ({ beekeeperWasmTest }) => {
+    const retVal = await beekeeperWasmTest(async ({ provider, BeekeeperInstanceHelper }, WALLET_OPTIONS_NODE, signData) => {
+      const api = new BeekeeperInstanceHelper(provider, WALLET_OPTIONS_NODE);
+
+      const session = api.createSession('pear');
+
+      api.create_with_password(session, 'w3', 'pass');
+
+      const key = api.importKey(session, 'w3', '5JNHfZYKGaomSFvd4NUdQ9qMcEAC43kujbfjueTHpVapX1Kzq2n');
+
+      const digests = new provider.StringList();
+      digests.push_back(signData[0].sig_digest);
+      digests.push_back(signData[1].sig_digest);
+
+      const signDigests = api.signDigests(session, digests, key);
+      digests.delete();
+
+      return {
+        signDigests,
+        expected: [ signData[0].expected_signature, signData[1].expected_signature ]
+      }
+    }, WALLET_OPTIONS_NODE, signData);
+
+    expect(retVal.signDigests).toStrictEqual(retVal.expected);
+  });
+
   test('Should be able to list wallets', async ({ beekeeperWasmTest }) => {
     const retVal = await beekeeperWasmTest(async ({ provider, BeekeeperInstanceHelper }, WALLET_OPTIONS_NODE) => {
       const api = new BeekeeperInstanceHelper(provider, WALLET_OPTIONS_NODE);
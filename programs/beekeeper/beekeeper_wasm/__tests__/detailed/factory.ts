@@ -251,6 +251,27 @@ test.describe('Beekeeper factory tests for Node.js', () => {
     });
   });
 
+  test('Should be able to sign a few digests at once', async ({ beekeeperTest }) => {
+    const retVal = await beekeeperTest(async ({ beekeeper }) => {
+      const digestStr = "390f34297cfcb8fa4b37353431ecbab05b8dc0c9c15fb9ca1a3d510c52177542";
+      // Convert hex string to Uint8Array
+      const uint8Array = new Uint8Array(digestStr.match(/.{1,2}/g)!.map(byte => parseInt(byte, 16)));
+
+      const session = beekeeper.createSession("my.salt");
+
+      const { wallet } = await session.createWallet('w0', 'mypassword');
+
+      const publicKey = await wallet.importKey('5JNHfZYKGaomSFvd4NUdQ9qMcEAC43kujbfjueTHpVapX1Kzq2n');
+
+      return {
+        batch: wallet.signDigests(publicKey, [ digestStr, uint8Array ]),
+        single: wallet.signDigest(publicKey, digestStr)
+      };
+    });
+
+    expect(retVal.batch).toStrictEqual([ retVal.single, retVal.single ]);
+  });
+
   test.afterAll(async () => {
     await browser.close();
   });
@@ -308,6 +308,26 @@ namespace beekeeper {
     return sign_digest_impl( token, sig_digest, public_key, std::optional<std::string>( wallet_name ) );
   }
 
+  std::string beekeeper_api::sign_digests_impl( const std::string& token, const std::vector<std::string>& sig_digests, const std::string& public_key, const std::optional<std::string>& wallet_name )
+  {
+    auto _method = [&, this]()
+    {
+      sign_digests_return _result = { _impl->app.get_wallet_manager()->sign_digests( token, wallet_name, sig_digests, create( public_key ), prefix ) };
+      return to_string( _result );
+    };
+    return exception_handler( _method );
+  }
+
+  std::string beekeeper_api::sign_digests( const std::string& token, const std::vector<std::string>& sig_digests, const std::string& public_key )
+  {
+    return sign_digests_impl( token, sig_digests, public_key, std::optional<std::string>() );
+  }
+
+  std::string beekeeper_api::sign_digests( const std::string& token, const std::vector<std::string>& sig_digests, const std::string& public_key, const std::string& wallet_name )
+  {
+    return sign_digests_impl( token, sig_digests, public_key, std::optional<std::string>( wallet_name ) );
+  }
+
   std::string beekeeper_api::get_info( const std::string& token )
   {
     auto _method = [&, this]()
@@ -53,6 +53,7 @@ class beekeeper_api final
     std::string create_impl( const std::string& token, const std::string& wallet_name, const std::optional<std::string>& password, const bool is_temporary );
     std::string get_public_keys_impl( const std::string& token, const std::optional<std::string>& wallet_name );
     std::string sign_digest_impl( const std::string& token, const std::string& sig_digest, const std::string& public_key, const std::optional<std::string>& wallet_name );
+    std::string sign_digests_impl( const std::string& token, const std::vector<std::string>& sig_digests, const std::string& public_key, const std::optional<std::string>& wallet_name );
 
   public:
 
@@ -97,6 +98,9 @@ class beekeeper_api final
     std::string sign_digest( const std::string& token, const std::string& sig_digest, const std::string& public_key );
     std::string sign_digest( const std::string& token, const std::string& sig_digest, const std::string& public_key, const std::string& wallet_name );
 
+    std::string sign_digests( const std::string& token, const std::vector<std::string>& sig_digests, const std::string& public_key );
+    std::string sign_digests( const std::string& token, const std::vector<std::string>& sig_digests, const std::string& public_key, const std::string& wallet_name );
+
     std::string get_info( const std::string& token );
     std::string get_version();
 
@@ -219,6 +219,23 @@ EMSCRIPTEN_BINDINGS(beekeeper_api_instance) {
     .function("sign_digest(token, sig_digest, public_key)", select_overload<std::string(const std::string&, const std::string&, const std::string&)>(&beekeeper_api::sign_digest))              //(1)
     .function("sign_digest(token, sig_digest, public_key, wallet_name)", select_overload<std::string(const std::string&, const std::string&, const std::string&, const std::string&)>(&beekeeper_api::sign_digest)) //(2)
 
+    /*
+      ****signing many transactions at once by signing their digests****
+      PARAMS:
+        token:        a token representing a session
+        sig_digests:  digests of transactions
+        public_key:   a public key corresponding to a private key that is stored in a wallet. It will be used for creation of signatures
+        wallet_name:  a name of wallet where public keys are searched
+                      If the name of wallet is:
+                       - not given, chosen is a version (1)
+                       -     given, chosen is a version (2)
+      RESULT:
+        { "signatures":["1f69e091fc79b0e8d1812fc662f12076561f9e38ffc212b901ae90fe559f863ad266fe459a8e946cff9bbe7e56ce253bbfab0cccdde944edc1d05161c61ae86340"]}
+        signatures: signatures of transactions, in the order of given digests
+    */
+    .function("sign_digests(token, sig_digests, public_key)", select_overload<std::string(const std::string&, const std::vector<std::string>&, const std::string&)>(&beekeeper_api::sign_digests))              //(1)
+    .function("sign_digests(token, sig_digests, public_key, wallet_name)", select_overload<std::string(const std::string&, const std::vector<std::string>&, const std::string&, const std::string&)>(&beekeeper_api::sign_digests)) //(2)
+
     /*
       ****information about a session****
       PARAMS:
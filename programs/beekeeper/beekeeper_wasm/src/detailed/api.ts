@@ -45,6 +45,13 @@ export class BeekeeperApi implements IBeekeeperInstance {
     }
   }
 
+  public createStringList(values: string[]) {
+    const list = new this.provider.StringList();
+    values.forEach((value) => void list.push_back(value));
+
+    return list;
+  }
+
   public async init() {
     await this.fs?.init(this.options.storageRoot);
 
@@ -152,6 +152,18 @@ export interface IBeekeeperUnlockedWallet extends IWallet {
    */
   signDigest(publicKey: TPublicKey, sigDigest: string | Uint8Array): TSignature;
 
+  /**
+   * Signs a batch of digests with the same key in a single beekeeper call
+   *
+   * @param {TPublicKey} publicKey public key in WIF format to match the private key in the wallet. It will be used to sign all of the provided digests
+   * @param {Array<string | Uint8Array>} sigDigests digests of transactions in hex format or as arrays of bytes to be signed
+   *
+   * @returns {TSignature[]} signatures in hex format, in the order of the given digests
+   *
+   * @throws {BeekeeperError} on any beekeeper API-related error (error parsing response, invalid input, timeout error, fs sync error etc.)
+   */
+  signDigests(publicKey: TPublicKey, sigDigests: Array<string | Uint8Array>): TSignature[];
+
   /**
    * Encrypts given data for a specific entity and returns the encrypted message
    *
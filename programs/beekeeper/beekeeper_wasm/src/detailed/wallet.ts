@@ -11,6 +11,10 @@ interface IBeekeeperSignature {
   signature: string;
 }
 
+interface IBeekeeperSignatures {
+  signatures: string[];
+}
+
 interface IBeekeeperKeys {
   keys: Array<{
     public_key: string;
@@ -29,6 +33,15 @@ interface IHasMatchingPrivateKey {
   exists: boolean;
 }
 
+const digestToHex = (sigDigest: string | Uint8Array): string => {
+  if (sigDigest instanceof Uint8Array) {
+    // Convert Uint8Array to hex string
+    return Array.from(sigDigest).map(b => b.toString(16).padStart(2, '0')).join('');
+  }
+
+  return sigDigest;
+};
+
 export class BeekeeperUnlockedWallet implements IBeekeeperUnlockedWallet {
   public constructor(
     private readonly api: BeekeeperApi,
@@ -72,16 +85,25 @@ export class BeekeeperUnlockedWallet implements IBeekeeperUnlockedWallet {
   }
 
   public signDigest(publicKey: string, sigDigest: string | Uint8Array): TSignature {
-    if (sigDigest instanceof Uint8Array) {
-      // Convert Uint8Array to hex string
-      sigDigest = Array.from(sigDigest).map(b => b.toString(16).padStart(2, '0')).join('');
-    }
+    const digest = digestToHex(sigDigest);
 
-    const result = this.api.extract(safeWasmCall(() => this.api.api.sign_digest(this.session.token, sigDigest, publicKey) as string, `signing digest with key '${publicKey}' using wallet '${this.locked.name}'`)) as IBeekeeperSignature;
+    const result = this.api.extract(safeWasmCall(() => this.api.api.sign_digest(this.session.token, digest, publicKey) as string, `signing digest with key '${publicKey}' using wallet '${this.locked.name}'`)) as IBeekeeperSignature;
 
     return result.signature;
   }
 
+  public signDigests(publicKey: string, sigDigests: Array<string | Uint8Array>): TSignature[] {
+    const digests = this.api.createStringList(sigDigests.map(digestToHex));
+
+    try {
+      const result = this.api.extract(safeWasmCall(() => this.api.api.sign_digests(this.session.token, digests, publicKey) as string, `signing ${sigDigests.length} digests with key '${publicKey}' using wallet '${this.locked.name}'`)) as IBeekeeperSignatures;
+
+      return result.signatures;
+    } finally {
+      safeWasmCall(() => digests.delete(), "StringList WASM object deletion");
+    }
+  }
+
   public getPublicKeys(): TPublicKey[] {
     const result = this.api.extract(safeWasmCall(() => this.api.api.get_public_keys(this.session.token, this.locked.name) as string, `public keys retrieval from wallet '${this.locked.name}'`)) as IBeekeeperKeys;
 
@@ -114,6 +114,22 @@ signature_type beekeeper_wallet_manager::sign_digest( const std::string& token,
   return sessions->get_wallet_manager( token )->sign_digest( wallet_name, digest_type( sig_digest ), public_key, prefix );
 }
 
+std::vector<signature_type> beekeeper_wallet_manager::sign_digests( const std::string& token, const std::optional<std::string>& wallet_name, const std::vector<std::string>& sig_digests, const public_key_type& public_key, const std::string& prefix )
+{
+  FC_ASSERT( sig_digests.size(), "`sig_digests` can't be empty" );
+
+  std::vector<digest_type> _digests;
+  _digests.reserve( sig_digests.size() );
+  for( const auto& sig_digest : sig_digests )
+  {
+    FC_ASSERT( sig_digest.size(), "`sig_digest` can't be empty" );
+    _digests.emplace_back( sig_digest );
+  }
+
+  sessions->check_timeout( token );
+  return sessions->get_wallet_manager( token )->sign_digests( wallet_name, _digests, public_key, prefix );
+}
+
 info beekeeper_wallet_manager::get_info( const std::string& token )
 {
   return sessions->get_info( token );
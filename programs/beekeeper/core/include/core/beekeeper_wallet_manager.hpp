@@ -68,6 +68,18 @@ public:
    */
   signature_type sign_digest( const std::string& token, const std::optional<std::string>& wallet_name, const std::string& sig_digest, const public_key_type& public_key, const std::string& prefix );
 
+  /**
+   * Sign many sig_digests using a private key corresponding to a public key. The session is validated once for the whole batch.
+   * @param token       Session's identifier.
+   * @param wallet_name A name of a wallet where a private key is stored. Optional. If not given, then a private key is searched in all unlocked wallets.
+   * @param sig_digests Signature digests.
+   * @param public_key  A public key corresponding to a private key that is stored in a wallet.
+   * @param prefix      A prefix of a public key
+   * @return            Signatures in the order of given digests.
+   * @throws            An exception `fc::exception` if a corresponding private key is not found in unlocked wallet/wallets.
+   */
+  std::vector<signature_type> sign_digests( const std::string& token, const std::optional<std::string>& wallet_name, const std::vector<std::string>& sig_digests, const public_key_type& public_key, const std::string& prefix );
+
   /**
    *
    * Create a new wallet.
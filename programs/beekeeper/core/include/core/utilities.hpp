@@ -227,6 +227,17 @@ struct sign_digest_args: public session_token_type
 };
 using sign_digest_return = signature_return;
 
+struct sign_digests_args: public session_token_type
+{
+  std::vector<std::string> sig_digests;
+  std::string public_key;
+  std::optional<std::string> wallet_name;
+};
+struct sign_digests_return
+{
+  std::vector<signature_type> signatures;
+};
+
 using get_info_args   = session_token_type;
 using get_info_return = info;
 using get_version_args   = void_type;
@@ -362,6 +373,8 @@ FC_REFLECT( beekeeper::list_wallets_return, (wallets) )
 FC_REFLECT( beekeeper::get_public_keys_return, (keys) )
 FC_REFLECT_DERIVED( beekeeper::sign_digest_args, (beekeeper::session_token_type), (sig_digest)(public_key)(wallet_name) )
 FC_REFLECT( beekeeper::signature_return, (signature) )
+FC_REFLECT_DERIVED( beekeeper::sign_digests_args, (beekeeper::session_token_type), (sig_digests)(public_key)(wallet_name) )
+FC_REFLECT( beekeeper::sign_digests_return, (signatures) )
 FC_REFLECT( beekeeper::create_session_args, (salt) )
 FC_REFLECT_DERIVED( beekeeper::get_public_keys_args, (beekeeper::session_token_type), (wallet_name) )
 FC_REFLECT_DERIVED( beekeeper::has_matching_private_key_args, (beekeeper::wallet_args), (public_key) )
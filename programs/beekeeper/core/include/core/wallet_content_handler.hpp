@@ -162,6 +162,10 @@ class wallet_content_handler
       */
       std::optional<signature_type> try_sign_digest( const digest_type& sig_digest, const public_key_type& public_key );
 
+      /* Attempts to sign many digests via the given public_key. Larger batches are signed by several threads.
+      */
+      std::optional<std::vector<signature_type>> try_sign_digests( const std::vector<digest_type>& sig_digests, const public_key_type& public_key );
+
       std::shared_ptr<detail::beekeeper_impl> my;
       void encrypt_keys();
 
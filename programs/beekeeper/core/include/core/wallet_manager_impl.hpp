@@ -37,6 +37,7 @@ class wallet_manager_impl {
     std::vector<std::string> import_keys( const std::string& name, const std::vector<std::string>& wif_keys, const std::string& prefix );
     void remove_key( const std::string& name, const public_key_type& public_key );
     signature_type sign_digest( const std::optional<std::string>& wallet_name, const digest_type& sig_digest, const public_key_type& public_key, const std::string& prefix );
+    std::vector<signature_type> sign_digests( const std::optional<std::string>& wallet_name, const std::vector<digest_type>& sig_digests, const public_key_type& public_key, const std::string& prefix );
     bool has_matching_private_key( const std::string& wallet_name, const public_key_type& public_key );
     std::string encrypt_data( const public_key_type& from_public_key, const public_key_type& to_public_key, const std::string& wallet_name, const std::string& content, const std::optional<unsigned int>& nonce, const std::string& prefix );
     std::string decrypt_data( const public_key_type& from_public_key, const public_key_type& to_public_key, const std::string& wallet_name, const std::string& encrypted_content );
@@ -57,7 +58,8 @@ class wallet_manager_impl {
     std::string gen_password();
     void valid_filename( const std::string& name );
 
-    signature_type sign( std::function<std::optional<signature_type>(const wallet_content_handler_session&)>&& sign_method, const std::optional<std::string>& wallet_name, const public_key_type& public_key, const std::string& prefix );
+    template<typename signature_result_type>
+    signature_result_type sign( std::function<std::optional<signature_result_type>(const wallet_content_handler_session&)>&& sign_method, const std::optional<std::string>& wallet_name, const public_key_type& public_key, const std::string& prefix );
 
     boost::filesystem::path create_wallet_filename( const std::string& wallet_name ) const
     {
@@ -1,6 +1,9 @@
 #include <core/wallet_content_handler.hpp>
 
 #include <fstream>
+#include <future>
+#include <thread>
+#include <algorithm>
 
 #include <fc/io/json.hpp>
 #include <fc/crypto/aes.hpp>
@@ -71,6 +74,69 @@ public:
     return it->second.first.sign_compact( sig_digest );
   }
 
+  std::optional<std::vector<signature_type>> try_sign_digests( const std::vector<digest_type>& sig_digests, const public_key_type& public_key )
+  {
+    auto it = _keys.find(public_key);
+    if( it == _keys.end() )
+    return std::optional<std::vector<signature_type>>();
+
+    const private_key_type& _private_key = it->second.first;
+    std::vector<signature_type> _signatures( sig_digests.size() );
+
+    auto _sign_range = [&]( size_t begin, size_t end )
+    {
+      for( size_t i = begin; i < end; ++i )
+        _signatures[i] = _private_key.sign_compact( sig_digests[i] );
+    };
+
+#ifdef __EMSCRIPTEN__
+    _sign_range( 0, sig_digests.size() );
+#else
+    /// Starting threads costs more than signing a few digests
+    constexpr size_t _min_digests_per_thread = 32;
+    const size_t _threads_count = std::min<size_t>( std::max( 1u, std::thread::hardware_concurrency() ),
+                                                    ( sig_digests.size() + _min_digests_per_thread - 1 ) / _min_digests_per_thread );
+    if( _threads_count <= 1 )
+    {
+      _sign_range( 0, sig_digests.size() );
+    }
+    else
+    {
+      const size_t _chunk_size = ( sig_digests.size() + _threads_count - 1 ) / _threads_count;
+      std::vector<std::future<void>> _signers;
+      for( size_t _begin = _chunk_size; _begin < sig_digests.size(); _begin += _chunk_size )
+        _signers.emplace_back( std::async( std::launch::async, _sign_range, _begin, std::min( _begin + _chunk_size, sig_digests.size() ) ) );
+
+      /// every range has to be finished before leaving, because all of them refer to local data
+      std::exception_ptr _first_exception;
+      try
+      {
+        _sign_range( 0, _chunk_size );
+      }
+      catch(...)
+      {
+        _first_exception = std::current_exception();
+      }
+      for( auto& _signer : _signers )
+      {
+        try
+        {
+          _signer.get();
+        }
+        catch(...)
+        {
+          if( !_first_exception )
+            _first_exception = std::current_exception();
+        }
+      }
+      if( _first_exception )
+        std::rethrow_exception( _first_exception );
+    }
+#endif
+
+    return _signatures;
+  }
+
   private_key_type get_private_key(const public_key_type& id)const
   {
     auto has_key = try_get_private_key( id );
@@ -354,6 +420,11 @@ std::optional<signature_type> wallet_content_handler::try_sign_digest( const dig
   return my->try_sign_digest( sig_digest, public_key );
 }
 
+std::optional<std::vector<signature_type>> wallet_content_handler::try_sign_digests( const std::vector<digest_type>& sig_digests, const public_key_type& public_key )
+{
+  return my->try_sign_digests( sig_digests, public_key );
+}
+
 std::pair<public_key_type,private_key_type> wallet_content_handler::get_private_key_from_password( std::string account, std::string role, std::string password )const
 {
   auto seed = account + role + password;
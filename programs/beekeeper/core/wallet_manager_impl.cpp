@@ -310,7 +310,8 @@ void wallet_manager_impl::remove_key( const std::string& name, const public_key_
   __wallet->get_content()->remove_key( public_key );
 }
 
-signature_type wallet_manager_impl::sign( std::function<std::optional<signature_type>(const wallet_content_handler_session&)>&& sign_method, const std::optional<std::string>& wallet_name, const public_key_type& public_key, const std::string& prefix )
+template<typename signature_result_type>
+signature_result_type wallet_manager_impl::sign( std::function<std::optional<signature_result_type>(const wallet_content_handler_session&)>&& sign_method, const std::optional<std::string>& wallet_name, const public_key_type& public_key, const std::string& prefix )
 {
   try
   {
@@ -318,7 +319,7 @@ signature_type wallet_manager_impl::sign( std::function<std::optional<signature_
     {
       if( !wallet.is_locked() )
         return sign_method( wallet );
-      return std::optional<signature_type>();
+      return std::optional<signature_result_type>();
     };
 
     if( wallet_name )
@@ -357,7 +358,12 @@ signature_type wallet_manager_impl::sign( std::function<std::optional<signature_
 
 signature_type wallet_manager_impl::sign_digest( const std::optional<std::string>& wallet_name, const digest_type& sig_digest, const public_key_type& public_key, const std::string& prefix )
 {
-  return sign( [&]( const wallet_content_handler_session& wallet ){ return wallet.get_content()->try_sign_digest( sig_digest, public_key ); }, wallet_name, public_key, prefix );
+  return sign<signature_type>( [&]( const wallet_content_handler_session& wallet ){ return wallet.get_content()->try_sign_digest( sig_digest, public_key ); }, wallet_name, public_key, prefix );
+}
+
+std::vector<signature_type> wallet_manager_impl::sign_digests( const std::optional<std::string>& wallet_name, const std::vector<digest_type>& sig_digests, const public_key_type& public_key, const std::string& prefix )
+{
+  return sign<std::vector<signature_type>>( [&]( const wallet_content_handler_session& wallet ){ return wallet.get_content()->try_sign_digests( sig_digests, public_key ); }, wallet_name, public_key, prefix );
 }
 
 bool wallet_manager_impl::has_matching_private_key( const std::string& wallet_name, const public_key_type& public_key )
@@ -7,6 +7,7 @@
 #include <fc/filesystem.hpp>
 #include <fc/io/json.hpp>
 #include <fc/log/logger.hpp>
+#include <fc/thread/thread.hpp>
 #include <fc/variant.hpp>
 
 #include <hive/chain/block_log.hpp>
@@ -21,9 +22,16 @@
 #include <hive/protocol/hardfork_block.hpp>
 
 #include <boost/program_options.hpp>
+#include <boost/scope_exit.hpp>
 
 #include <string>
 #include <memory>
+#include <algorithm>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <exception>
 
 #include "../base/conversion_plugin.hpp"
 
@@ -38,6 +46,54 @@ namespace detail {
   using hive::chain::block_log;
   using hive::chain::block_log_wrapper;
 
+  /// Bounded queue passing blocks between conversion stages. Producer waits while the queue is full,
+  /// so a slow stage holds back the ones before it instead of letting the buffered blocks grow.
+  template< typename T >
+  class stage_queue
+  {
+  public:
+    explicit stage_queue( size_t capacity ) : capacity( capacity ) {}
+
+    /// Returns false if the queue has been closed (consumer stopped)
+    bool push( T item )
+    {
+      std::unique_lock< std::mutex > lock( mtx );
+      cv.wait( lock, [&]() { return closed || items.size() < capacity; } );
+      if( closed )
+        return false;
+      items.emplace_back( std::move( item ) );
+      cv.notify_all();
+      return true;
+    }
+
+    /// Returns false if the queue has been closed and there are no more items
+    bool pop( T& item )
+    {
+      std::unique_lock< std::mutex > lock( mtx );
+      cv.wait( lock, [&]() { return closed || !items.empty(); } );
+      if( items.empty() )
+        return false;
+      item = std::move( items.front() );
+      items.pop_front();
+      cv.notify_all();
+      return true;
+    }
+
+    void close()
+    {
+      std::lock_guard< std::mutex > lock( mtx );
+      closed = true;
+      cv.notify_all();
+    }
+
+  private:
+    std::mutex              mtx;
+    std::condition_variable cv;
+    std::deque< T >         items;
+    const size_t            capacity;
+    bool                    closed = false;
+  };
+
   class block_log_conversion_plugin_impl final : public conversion_plugin_impl {
   public:
     std::shared_ptr< block_log_wrapper > log_reader;
@@ -51,6 +107,9 @@ namespace detail {
     void open( const fc::path& input, const fc::path& output );
     void close();
 
+    /// Maximum number of blocks waiting between reading, conversion and writing stages
+    size_t queue_size = 1000;
+
     appbase::application& theApp;
     hive::chain::blockchain_worker_thread_pool thread_pool;
   };
@@ -154,11 +213,64 @@ namespace detail {
     if( !stop_block_num || stop_block_num > log_reader->head_block()->get_block_num() )
       stop_block_num = log_reader->head_block()->get_block_num();
 
-    for( ; start_block_num <= stop_block_num && !theApp.is_interrupt_request(); ++start_block_num )
-    {
-      std::shared_ptr<hive::chain::full_block_type> _full_block = log_reader->read_block_by_num( start_block_num );
-      FC_ASSERT( _full_block, "unable to read block", ("block_num", start_block_num) );
+    // Conversion itself is sequential (each block refers to the id of the previous converted one), but reading
+    // (with decompression) and writing (with compression) of blocks are done by separate threads meanwhile
+    typedef std::shared_ptr<hive::chain::full_block_type> full_block_ptr;
+    stage_queue< full_block_ptr > read_blocks( queue_size );
+    stage_queue< full_block_ptr > converted_blocks( queue_size );
+    std::exception_ptr reader_exception;
+    std::exception_ptr writer_exception;
+
+    std::thread reader( [&, block_num = start_block_num]() mutable {
+      fc::set_thread_name( "conv_reader" );
+      fc::thread::current().set_name( "conv_reader" );
+      try
+      {
+        for( ; block_num <= stop_block_num && !theApp.is_interrupt_request(); ++block_num )
+        {
+          full_block_ptr _full_block = log_reader->read_block_by_num( block_num );
+          FC_ASSERT( _full_block, "unable to read block", ("block_num", block_num) );
+          _full_block->get_block(); // unpack here, not in the conversion stage
+          if( !read_blocks.push( std::move( _full_block ) ) )
+            break;
+        }
+      }
+      catch( ... )
+      {
+        reader_exception = std::current_exception();
+      }
+      read_blocks.close();
+    } );
 
+    std::thread writer( [&]() {
+      fc::set_thread_name( "conv_writer" );
+      fc::thread::current().set_name( "conv_writer" );
+      try
+      {
+        full_block_ptr fb;
+        while( converted_blocks.pop( fb ) )
+          log_out.append( fb, false );
+      }
+      catch( ... )
+      {
+        writer_exception = std::current_exception();
+      }
+      converted_blocks.close();
+      read_blocks.close(); // nothing will be written anymore, so stop reading too
+    } );
+
+    BOOST_SCOPE_EXIT( &read_blocks, &converted_blocks, &reader, &writer ) {
+      read_blocks.close();
+      converted_blocks.close();
+      if( reader.joinable() )
+        reader.join();
+      if( writer.joinable() )
+        writer.join();
+    } BOOST_SCOPE_EXIT_END
+
+    full_block_ptr _full_block;
+    for( ; start_block_num <= stop_block_num && !theApp.is_interrupt_request() && read_blocks.pop( _full_block ); ++start_block_num )
+    {
       hp::signed_block block = _full_block->get_block(); // Copy required due to the const reference returned by the get_block function
       print_pre_conversion_data( block );
 
@@ -166,7 +278,8 @@ namespace detail {
       last_block_id = fb->get_block_id();
       converter.on_tapos_change();
 
-      log_out.append( fb, false );
+      if( !converted_blocks.push( fb ) )
+        break;
 
       print_progress( start_block_num, stop_block_num );
       print_post_conversion_data( block );
@@ -174,6 +287,17 @@ namespace detail {
       head_block_time = block.timestamp;
     }
 
+    // let the writer drain what has been converted, then report any failure of the side stages
+    converted_blocks.close();
+    writer.join();
+    read_blocks.close();
+    reader.join();
+
+    if( reader_exception )
+      std::rethrow_exception( reader_exception );
+    if( writer_exception )
+      std::rethrow_exception( writer_exception );
+
     if( !theApp.is_interrupt_request() )
       theApp.kill();
   }
@@ -195,7 +319,11 @@ namespace detail {
   block_log_conversion_plugin::block_log_conversion_plugin(): appbase::plugin<block_log_conversion_plugin>() {}
   block_log_conversion_plugin::~block_log_conversion_plugin() {}
 
-  void block_log_conversion_plugin::set_program_options( bpo::options_description& cli, bpo::options_description& cfg ) {}
+  void block_log_conversion_plugin::set_program_options( bpo::options_description& cli, bpo::options_description& cfg )
+  {
+    cfg.add_options()
+      ( "conversion-queue-size", bpo::value< size_t >()->default_value( 1000 ), "Maximum number of blocks buffered between reading, conversion and writing threads" );
+  }
 
   void block_log_conversion_plugin::plugin_initialize( const bpo::variables_map& options )
   {
@@ -234,6 +362,7 @@ namespace detail {
 
     my->log_per_block = options["log-per-block"].as< uint32_t >();
     my->log_specific = options["log-specific"].as< uint32_t >();
+    my->queue_size = std::max< size_t >( options["conversion-queue-size"].as< size_t >(), 1 );
 
     my->set_wifs( options.count("use-same-key"), options["owner-key"].as< std::string >(), options["active-key"].as< std::string >(), options["posting-key"].as< std::string >() );
 
@@ -134,6 +134,10 @@ void append_full_block_data(const std::shared_ptr<hive::chain::full_block_type>
   start_offset += uncompressed.raw_size + sizeof(start_offset);
 }
 
+// The checksum is a running sha256 over the uncompressed block_log (so it matches a plain `sha256sum` of a legacy file),
+// which can only be fed one block after another.  for_each_block decompresses blocks on the worker pool ahead of the
+// encoder, so for a single file only the hashing itself is serial; separate files are handled in parallel by
+// validate_block_log_checksums_from_file.
 void checksum_block_log(const fc::path &block_log, fc::optional<uint32_t> checkpoint_every_n_blocks, appbase::application &app, hive::chain::blockchain_worker_thread_pool &thread_pool)
 {
   try
@@ -315,19 +319,57 @@ block_logs_and_hashes_type parse_checkpoints(const fc::path &checkpoints_file)
   FC_CAPTURE_AND_RETHROW()
 }
 
-bool validate_block_log_checksums_from_file(const fc::path &checksums_file, appbase::application &app, hive::chain::blockchain_worker_thread_pool &thread_pool)
+bool validate_block_log_checksums_from_file(const fc::path &checksums_file, unsigned max_concurrent_files, appbase::application &app, hive::chain::blockchain_worker_thread_pool &thread_pool)
 {
   try
   {
     block_logs_and_hashes_type hashes_in_checksums_file = parse_checkpoints(checksums_file);
-    unsigned fail_count = 0;
-    for (const auto &[block_log, hashes_to_validate] : hashes_in_checksums_file)
-      if (!validate_block_log_checksum(block_log, hashes_to_validate, app, thread_pool))
-        ++fail_count;
+
+    // the checksum of a single file is a running sha256, so it can't be split, but separate files (e.g. parts of
+    // a split block log) don't depend on each other and can be validated at the same time
+    std::vector<block_logs_and_hashes_type::const_iterator> files_to_validate;
+    for (auto it = hashes_in_checksums_file.cbegin(); it != hashes_in_checksums_file.cend(); ++it)
+      files_to_validate.push_back(it);
+
+    std::atomic<size_t> next_file_index = 0;
+    std::atomic<unsigned> fail_count = 0;
+    std::mutex first_exception_mutex;
+    std::exception_ptr first_exception;
+
+    const auto validate_files = [&](unsigned validator_number)
+    {
+      const std::string thread_name = "validate_" + std::to_string(validator_number);
+      fc::set_thread_name(thread_name.c_str()); // tells the OS the thread's name
+      fc::thread::current().set_name(thread_name); // tells fc the thread's name for logging
+      try
+      {
+        for (size_t i = next_file_index++; i < files_to_validate.size(); i = next_file_index++)
+          if (!validate_block_log_checksum(files_to_validate[i]->first, files_to_validate[i]->second, app, thread_pool))
+            ++fail_count;
+      }
+      catch (...)
+      {
+        std::lock_guard<std::mutex> guard(first_exception_mutex);
+        if (!first_exception)
+          first_exception = std::current_exception();
+        next_file_index = files_to_validate.size(); // let other validators finish early
+      }
+    };
+
+    const unsigned validators_count = std::max(1u, std::min<unsigned>(max_concurrent_files, files_to_validate.size()));
+    std::vector<std::thread> validators;
+    for (unsigned i = 0; i < validators_count; ++i)
+      validators.emplace_back(validate_files, i);
+    for (std::thread &validator : validators)
+      validator.join();
+
+    if (first_exception)
+      std::rethrow_exception(first_exception);
+
     if (fail_count)
     {
       std::cerr << "checksums file had " << fail_count << " checksums that did NOT match\n";
-      elog("checksums file had ${fail_count} checksums that did NOT match", (fail_count));
+      elog("checksums file had ${fail_count} checksums that did NOT match", ("fail_count", fail_count.load()));
     }
     else
     {
@@ -497,7 +539,7 @@ fc::optional<uint64_t> is_data_at_file_position_a_plausible_offset_and_flags(int
   if (block_offset_with_flags & 0x0100000000000000ull)
   {
     // if the dictionary flag bit is set, verify that the dictionary number is one that we have.
-    dictionary_is_plausible = *flags.dictionary_number <= hive::chain::get_last_available_zstd_compression_dictionary_number().value_or(0);
+    dictionary_is_plausible = hive::chain::is_known_zstd_compression_dictionary_number(*flags.dictionary_number);
   }
   else
   {
@@ -514,6 +556,9 @@ bool find_end(const fc::path &block_log_filename)
   {
     bool possible_end_found = false;
 
+    // blocks compressed with local dictionaries are only plausible if those dictionaries are known
+    hive::chain::load_local_zstd_compression_dictionaries(block_log_filename.parent_path());
+
     int block_log_fd = open(block_log_filename.string().c_str(), O_RDONLY | O_CLOEXEC, 0644);
     if (block_log_fd == -1)
       FC_THROW("Error opening block log file ${block_log_filename}: ${error}", (block_log_filename)("error", strerror(errno)));
@@ -928,6 +973,7 @@ bool merge_block_logs(const fc::path &input_block_log_dir, const fc::path &outpu
       dlog("Creating directories: ${output_block_log_dir}", (output_block_log_dir));
       fc::create_directories(output_block_log_dir);
     }
+    hive::chain::copy_local_zstd_compression_dictionaries(input_block_log_dir, output_block_log_dir);
     const auto block_log_writer = hive::chain::block_log_wrapper::create_opened_wrapper(output_block_log_dir.generic_string() + "/" + hive::chain::block_log_file_name_info::_legacy_file_name,
       app, thread_pool, false /* read_only */);
 
@@ -959,12 +1005,12 @@ int main(int argc, char **argv)
   block_log_operations.add_options()("get-block-artifacts", "Get range of artifacts. Allows to run full artifacts verification, (Block_log opened in RO mode)");
   block_log_operations.add_options()("get-block-ids", "Get range of blocks ids. (Block_log opened in RO mode)");
   block_log_operations.add_options()("get-head-block-number", "Get block_log head block number. (Block_log opened in RO mode)");
-  block_log_operations.add_options()("sha256sum", "Verify sha256 checksums in block-log. (Block_log opened in RO mode)");
+  block_log_operations.add_options()("sha256sum", "Verify sha256 checksums in block-log. Blocks are decompressed by `jobs` worker threads, but the checksum of a single file is a running sha256 computed on one thread. (Block_log opened in RO mode)");
   block_log_operations.add_options()("split", "Split legacy monolithic block log file into new-style multiple part files.");
   block_log_operations.add_options()("truncate", "Truncate block log to given block number.");
 
   boost::program_options::options_description additional_operations("additional operations");
-  additional_operations.add_options()("verify-checksums-from-file", boost::program_options::value<boost::filesystem::path>()->value_name("filename"), "Verify sha256 from text file.");
+  additional_operations.add_options()("verify-checksums-from-file", boost::program_options::value<boost::filesystem::path>()->value_name("filename"), "Verify sha256 from text file. Up to `jobs` block_log files listed there are verified in parallel.");
   additional_operations.add_options()("merge-block-logs", "Merge new-style split block log part files into legacy monolithic single file.");
 
   boost::program_options::options_description merge_block_logs_options("merge-block-logs options");
@@ -1010,7 +1056,7 @@ int main(int argc, char **argv)
   get_block_artifacts_options.add_options()("from", boost::program_options::value<int32_t>()->value_name("n"), "Return range of artifacts from given block number (inclusive). Negative numbers mean distance from end (-1 is head block). Defaults to 1.");
   get_block_artifacts_options.add_options()("to", boost::program_options::value<int32_t>()->value_name("m"), "Return range of artifacts to given block number (inclusive). Negative numbers mean distance from end (-1 is head block). Defaults to -1.");
   get_block_artifacts_options.add_options()("header-only", "only print the artifacts header");
-  get_block_artifacts_options.add_options()("do-full-artifacts-verification-match-check", "Performs check if all artifacts from file matches block_log");
+  get_block_artifacts_options.add_options()("do-full-artifacts-verification-match-check", "Performs check if all artifacts from file matches block_log. Blocks are decoded by `jobs` worker threads ahead of the check.");
 
   // args for split subcommand
   boost::program_options::options_description split_block_log_options("split options");
@@ -1129,7 +1175,7 @@ int main(int argc, char **argv)
       shutdown_executor se(threads_num);
 
       dlog("block_log_util will perform verify-checksums-from-file operation on file: ${path_to_file}", (path_to_file));
-      return validate_block_log_checksums_from_file(path_to_file, se.the_app, se.thread_pool) ? 0 : 1;
+      return validate_block_log_checksums_from_file(path_to_file, threads_num, se.the_app, se.thread_pool) ? 0 : 1;
     }
     else if (options_map.count("merge-block-logs"))
     {
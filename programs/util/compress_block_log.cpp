@@ -22,11 +22,14 @@
 #include <mutex>
 #include <condition_variable>
 #include <queue>
+#include <algorithm>
+#include <iterator>
 
 #ifndef ZSTD_STATIC_LINKING_ONLY
 # define ZSTD_STATIC_LINKING_ONLY
 #endif
 #include <zstd.h>
+#include <zdict.h>
 
 #undef dlog
 #define dlog(...) do {} while(0)
@@ -50,12 +53,25 @@ struct compressed_block
 
 bool enable_zstd = true;
 fc::optional<int> zstd_level;
+// when more than one level is given, every block is compressed at each of them and the smallest result is kept
+std::vector<int> zstd_candidate_levels;
+// levels decompressing slower than this (in MB/s) are not acceptable, unless no candidate level meets the target;
+// since that needs timing, a single level is chosen per range of blocks from a sample measured up front
+fc::optional<uint32_t> min_decompression_throughput;
+uint32_t level_selection_range = 100000;
+uint32_t level_selection_samples = 100;
+uint32_t level_selection_repeats = 5;
+// maps first block of a range to the zstd level chosen for all blocks in it
+std::map<uint32_t, int> zstd_level_by_range;
 bool use_compressed_even_when_larger = true;
 
 uint32_t starting_block_number = 1;
 fc::optional<uint32_t> blocks_to_compress;
 fc::optional<fc::path> raw_block_output_path;
 bool benchmark_decompression = false;
+bool train_dictionary = false;
+uint32_t dictionary_training_samples = 20000;
+size_t dictionary_target_size = 220 * 1024;
 
 std::mutex queue_mutex;
 std::condition_variable queue_condition_variable;
@@ -70,12 +86,31 @@ uint64_t total_zstd_size = 0;
 fc::microseconds total_zstd_compression_time;
 fc::microseconds total_zstd_decompression_time;
 std::map<hive::chain::block_log::block_flags, uint32_t> total_count_by_method;
+std::map<int, uint32_t> total_count_by_zstd_level;
 
 const uint32_t blocks_to_prefetch = 100;
 const uint32_t max_completed_queue_size = 100;
 
 std::atomic<bool> error_detected {false};
 
+std::optional<uint8_t> get_dictionary_number_for_block(uint32_t block_number)
+{
+  // prefer a dictionary trained locally on the range the block comes from, fall back to the ones built into hived
+  std::optional<uint8_t> dictionary_number = hive::chain::get_local_zstd_compression_dictionary_number_for_block(block_number);
+  if (!dictionary_number)
+    dictionary_number = hive::chain::get_best_available_zstd_compression_dictionary_number_for_block(block_number);
+  return dictionary_number;
+}
+
+// candidate levels to compress given block with - the level chosen for its range if there is one
+std::vector<int> get_zstd_levels_for_block(uint32_t block_number)
+{
+  auto iter = zstd_level_by_range.upper_bound(block_number);
+  if (iter == zstd_level_by_range.begin())
+    return zstd_candidate_levels;
+  return { std::prev(iter)->second };
+}
+
 void compress_blocks(uint32_t& current_block_num)
 {
   // each compression thread gets its own context
@@ -119,41 +154,53 @@ void compress_blocks(uint32_t& current_block_num)
       std::unique_ptr<char[]> data;
       hive::chain::block_log::block_flags method;
       std::optional<uint8_t> dictionary_number;
+      int zstd_level = 0;
     };
     std::vector<compressed_data> compressed_versions;
 
-    std::optional<uint8_t> dictionary_number_to_use = hive::chain::get_best_available_zstd_compression_dictionary_number_for_block(uncompressed->block_number);
+    std::optional<uint8_t> dictionary_number_to_use = get_dictionary_number_for_block(uncompressed->block_number);
 
     // zstd
     if (enable_zstd)
     {
-      compressed_data zstd_compressed_data;
-      fc::time_point before = fc::time_point::now();
-      //idump((uncompressed->block_number)(uncompressed->uncompressed_block_size));
-      std::tie(zstd_compressed_data.data, zstd_compressed_data.size) = 
-        hive::chain::block_log_compression::compress_block_zstd(
-          uncompressed->uncompressed_block_data.get(),
-          uncompressed->uncompressed_block_size,
-          dictionary_number_to_use, zstd_level,
-          zstd_compression_context);
-      //idump((fc::to_hex(zstd_compressed_data.data.get(), zstd_compressed_data.size))(uncompressed->uncompressed_block_size)(zstd_compressed_data.size));
-      //idump((zstd_compressed_data.size));
-
-      fc::time_point after_compress = fc::time_point::now();
-      if (benchmark_decompression)
-        hive::chain::block_log_compression::decompress_block_zstd(zstd_compressed_data.data.get(),
-          zstd_compressed_data.size, dictionary_number_to_use, zstd_decompression_context);
-      fc::time_point after_decompress = fc::time_point::now();
-      zstd_compressed_data.method = hive::chain::block_log::block_flags::zstd;
-      zstd_compressed_data.dictionary_number = dictionary_number_to_use;
+      std::vector<compressed_data> zstd_versions;
+      for (const int level : get_zstd_levels_for_block(uncompressed->block_number))
+      {
+        compressed_data zstd_compressed_data;
+        fc::time_point before = fc::time_point::now();
+        //idump((uncompressed->block_number)(uncompressed->uncompressed_block_size));
+        std::tie(zstd_compressed_data.data, zstd_compressed_data.size) = 
+          hive::chain::block_log_compression::compress_block_zstd(
+            uncompressed->uncompressed_block_data.get(),
+            uncompressed->uncompressed_block_size,
+            dictionary_number_to_use, level,
+            zstd_compression_context);
+        //idump((fc::to_hex(zstd_compressed_data.data.get(), zstd_compressed_data.size))(uncompressed->uncompressed_block_size)(zstd_compressed_data.size));
+        //idump((zstd_compressed_data.size));
+
+        fc::time_point after_compress = fc::time_point::now();
+        if (benchmark_decompression)
+          hive::chain::block_log_compression::decompress_block_zstd(zstd_compressed_data.data.get(),
+            zstd_compressed_data.size, dictionary_number_to_use, zstd_decompression_context);
+        fc::time_point after_decompress = fc::time_point::now();
+        zstd_compressed_data.method = hive::chain::block_log::block_flags::zstd;
+        zstd_compressed_data.dictionary_number = dictionary_number_to_use;
+        zstd_compressed_data.zstd_level = level;
+
+        {
+          std::unique_lock<std::mutex> lock(queue_mutex);
+          total_zstd_compression_time += after_compress - before;
+          total_zstd_decompression_time += after_decompress - after_compress;
+        }
+        zstd_versions.push_back(std::move(zstd_compressed_data));
+      }
 
       {
         std::unique_lock<std::mutex> lock(queue_mutex);
-        total_zstd_size += zstd_compressed_data.size;
-        total_zstd_compression_time += after_compress - before;
-        total_zstd_decompression_time += after_decompress - after_compress;
+        total_zstd_size += std::min_element(zstd_versions.begin(), zstd_versions.end(),
+          [](const compressed_data& lhs, const compressed_data& rhs) { return lhs.size < rhs.size; })->size;
       }
-      compressed_versions.push_back(std::move(zstd_compressed_data));
+      std::move(zstd_versions.begin(), zstd_versions.end(), std::back_inserter(compressed_versions));
     }
 
     // sort by size
@@ -167,6 +214,8 @@ void compress_blocks(uint32_t& current_block_num)
           compressed_versions.front().size < uncompressed->uncompressed_block_size)
       {
         ++total_count_by_method[compressed_versions.front().method];
+        if (compressed_versions.front().method == hive::chain::block_log::block_flags::zstd)
+          ++total_count_by_zstd_level[compressed_versions.front().zstd_level];
         compressed->attributes.flags = compressed_versions.front().method;
         compressed->attributes.dictionary_number = compressed_versions.front().dictionary_number;
         compressed->compressed_block_size = compressed_versions.front().size;
@@ -359,6 +408,144 @@ void fill_pending_queue(const fc::path &input_path, const bool read_only, uint32
   }
 }
 
+void train_zstd_dictionary(const fc::path& input_path, const bool read_only, const fc::path& output_path, appbase::application& app, hive::chain::blockchain_worker_thread_pool& thread_pool)
+{
+  auto log_reader = hive::chain::block_log_wrapper::create_opened_wrapper( input_path, app, thread_pool, read_only );
+  if (!log_reader->head_block())
+    FC_THROW("input block log is empty");
+
+  uint32_t head_block_num = log_reader->head_block_num();
+  uint32_t stop_at_block = blocks_to_compress ? std::min(starting_block_number + *blocks_to_compress - 1, head_block_num) : head_block_num;
+  FC_ASSERT(starting_block_number <= stop_at_block, "Nothing to train the dictionary on");
+
+  std::optional<uint8_t> dictionary_number = hive::chain::get_next_free_local_zstd_compression_dictionary_number();
+  FC_ASSERT(dictionary_number, "All local dictionary numbers are already in use");
+
+  // spread the samples evenly over the range, so the dictionary reflects all of it and not just its beginning
+  const uint32_t block_count = stop_at_block - starting_block_number + 1;
+  const uint32_t sample_count = std::min(block_count, dictionary_training_samples);
+  ilog("Training dictionary ${dictionary_number} on ${sample_count} blocks sampled from range ${starting_block_number} to ${stop_at_block}",
+       ("dictionary_number", *dictionary_number)(sample_count)(starting_block_number)(stop_at_block));
+
+  std::vector<char> samples;
+  std::vector<size_t> sample_sizes;
+  sample_sizes.reserve(sample_count);
+  for (uint32_t i = 0; i < sample_count && !error_detected.load(); ++i)
+  {
+    const uint32_t block_number = starting_block_number + (uint32_t)((uint64_t)i * block_count / sample_count);
+    std::tuple<std::unique_ptr<char[]>, size_t> raw_block_data =
+      hive::chain::block_log_compression::decompress_raw_block(log_reader->read_common_raw_block_data_by_num(block_number));
+    const char* data = std::get<0>(raw_block_data).get();
+    samples.insert(samples.end(), data, data + std::get<1>(raw_block_data));
+    sample_sizes.push_back(std::get<1>(raw_block_data));
+  }
+  log_reader->close_storage();
+
+  std::unique_ptr<char[]> dictionary(new char[dictionary_target_size]);
+  size_t dictionary_size = ZDICT_trainFromBuffer(dictionary.get(), dictionary_target_size, samples.data(), sample_sizes.data(), (unsigned)sample_sizes.size());
+  if (ZDICT_isError(dictionary_size))
+    FC_THROW("Error training dictionary: ${error}", ("error", ZDICT_getErrorName(dictionary_size)));
+
+  // the dictionary has to be stored next to the output block log, it is needed to decompress its blocks
+  fc::path dictionary_path = output_path.parent_path() / hive::chain::get_local_zstd_compression_dictionary_file_name(*dictionary_number, starting_block_number);
+  {
+    std::ofstream dictionary_stream(dictionary_path.generic_string(), std::ios::out | std::ios::binary | std::ios::trunc);
+    dictionary_stream.write(dictionary.get(), dictionary_size);
+    FC_ASSERT(dictionary_stream.good(), "Error writing dictionary to ${dictionary_path}", (dictionary_path));
+  }
+  hive::chain::add_local_zstd_compression_dictionary(*dictionary_number, starting_block_number, std::move(dictionary), dictionary_size);
+  ilog("Saved ${dictionary_size} bytes dictionary to ${dictionary_path}", (dictionary_size)(dictionary_path));
+}
+
+// Chooses one zstd level for every range of level_selection_range blocks, so the choice doesn't depend on the
+// timing of individual blocks. Each candidate level compresses a sample of blocks spread over the range, every sample
+// is decompressed a few times and the fastest run counts. The smallest level meeting the throughput target wins.
+void select_zstd_levels(const fc::path& input_path, const bool read_only, appbase::application& app, hive::chain::blockchain_worker_thread_pool& thread_pool)
+{
+  auto log_reader = hive::chain::block_log_wrapper::create_opened_wrapper( input_path, app, thread_pool, read_only );
+  if (!log_reader->head_block())
+    FC_THROW("input block log is empty");
+
+  uint32_t head_block_num = log_reader->head_block_num();
+  uint32_t stop_at_block = blocks_to_compress ? std::min(starting_block_number + *blocks_to_compress - 1, head_block_num) : head_block_num;
+
+  ZSTD_CCtx* zstd_compression_context = ZSTD_createCCtx();
+  ZSTD_DCtx* zstd_decompression_context = ZSTD_createDCtx();
+  // bytes per nanosecond happen to be GB/s, hence the scaling of MB/s target
+  const double min_bytes_per_ns = *min_decompression_throughput / 1000.0;
+
+  for (uint32_t range_start = starting_block_number; range_start <= stop_at_block && !error_detected.load(); )
+  {
+    const uint32_t range_end = std::min<uint64_t>((uint64_t)range_start + level_selection_range - 1, stop_at_block);
+    const uint32_t block_count = range_end - range_start + 1;
+    const uint32_t sample_count = std::min(block_count, level_selection_samples);
+
+    struct level_statistics
+    {
+      int level;
+      uint64_t compressed_size = 0;
+      uint64_t uncompressed_size = 0;
+      std::chrono::nanoseconds decompression_time {0};
+    };
+    std::vector<level_statistics> statistics;
+    for (const int level : zstd_candidate_levels)
+      statistics.push_back(level_statistics{level});
+
+    for (uint32_t i = 0; i < sample_count; ++i)
+    {
+      const uint32_t block_number = range_start + (uint32_t)((uint64_t)i * block_count / sample_count);
+      std::tuple<std::unique_ptr<char[]>, size_t> raw_block_data =
+        hive::chain::block_log_compression::decompress_raw_block(log_reader->read_common_raw_block_data_by_num(block_number));
+      const std::optional<uint8_t> dictionary_number = get_dictionary_number_for_block(block_number);
+
+      for (level_statistics& level_stats : statistics)
+      {
+        std::unique_ptr<char[]> compressed_data;
+        size_t compressed_size;
+        std::tie(compressed_data, compressed_size) =
+          hive::chain::block_log_compression::compress_block_zstd(std::get<0>(raw_block_data).get(), std::get<1>(raw_block_data),
+                                                                  dictionary_number, level_stats.level, zstd_compression_context);
+        std::chrono::nanoseconds fastest_decompression = std::chrono::nanoseconds::max();
+        for (uint32_t repeat = 0; repeat < level_selection_repeats; ++repeat)
+        {
+          const auto decompression_start = std::chrono::steady_clock::now();
+          hive::chain::block_log_compression::decompress_block_zstd(compressed_data.get(), compressed_size,
+                                                                    dictionary_number, zstd_decompression_context);
+          fastest_decompression = std::min<std::chrono::nanoseconds>(fastest_decompression, std::chrono::steady_clock::now() - decompression_start);
+        }
+        level_stats.compressed_size += compressed_size;
+        level_stats.uncompressed_size += std::get<1>(raw_block_data);
+        level_stats.decompression_time += fastest_decompression;
+      }
+    }
+
+    const auto too_slow = [&](const level_statistics& level_stats) {
+      return level_stats.decompression_time.count() > 0 &&
+             level_stats.uncompressed_size / (double)level_stats.decompression_time.count() < min_bytes_per_ns;
+    };
+    auto chosen = statistics.end();
+    for (auto iter = statistics.begin(); iter != statistics.end(); ++iter)
+      if (!too_slow(*iter) && (chosen == statistics.end() || iter->compressed_size < chosen->compressed_size))
+        chosen = iter;
+    if (chosen == statistics.end())
+    {
+      // nothing meets the target, so take the fastest one
+      chosen = std::min_element(statistics.begin(), statistics.end(),
+        [](const level_statistics& lhs, const level_statistics& rhs) { return lhs.decompression_time < rhs.decompression_time; });
+    }
+
+    ilog("Using zstd level ${level} for blocks ${range_start} to ${range_end}", ("level", chosen->level)(range_start)(range_end));
+    zstd_level_by_range[range_start] = chosen->level;
+    range_start = range_end + 1;
+    if (range_start == 0)
+      break; // wrapped around after the last possible block
+  }
+
+  ZSTD_freeCCtx(zstd_compression_context);
+  ZSTD_freeDCtx(zstd_decompression_context);
+  log_reader->close_storage();
+}
+
 template<typename Func>
 void function_wrapper(const Func& function, const std::string function_name)
 {
@@ -434,6 +621,11 @@ int main(int argc, char** argv)
     boost::program_options::options_description options("Allowed options");
     options.add_options()("decompress", boost::program_options::bool_switch()->default_value(false), "Instead of compressing the block log, decompress it");
     options.add_options()("zstd-level", boost::program_options::value<int>()->default_value(15), zstd_levels_description.c_str());
+    options.add_options()("zstd-candidate-levels", boost::program_options::value<std::vector<int>>()->multitoken(), "Compress each block at every one of these zstd levels and store the smallest result (overrides zstd-level)");
+    options.add_options()("min-decompression-throughput", boost::program_options::value<uint32_t>(), "With zstd-candidate-levels, pick for each range of blocks the level giving the smallest sample still decompressing at least this many MB/s");
+    options.add_options()("level-selection-range", boost::program_options::value<uint32_t>()->default_value(100000), "The number of blocks sharing one zstd level chosen by min-decompression-throughput");
+    options.add_options()("level-selection-samples", boost::program_options::value<uint32_t>()->default_value(100), "The number of blocks sampled from each range to choose its zstd level");
+    options.add_options()("level-selection-repeats", boost::program_options::value<uint32_t>()->default_value(5), "How many times each sample is decompressed when choosing a zstd level; the fastest run counts");
     options.add_options()("benchmark-decompression", "decompress each block and report the decompression times at the end");
     options.add_options()("jobs,j", boost::program_options::value<int>()->default_value(1), "The number of threads to use for compression");
     options.add_options()("input-block-log,i", boost::program_options::value<std::string>(), "The file (or 1st file when split) containing the input block log. Has rights to read and write.");
@@ -442,6 +634,9 @@ int main(int argc, char** argv)
     options.add_options()("dump-raw-blocks", boost::program_options::value<std::string>(), "A directory in which to dump raw, uncompressed blocks (one block per file)");
     options.add_options()("starting-block-number,s", boost::program_options::value<uint32_t>()->default_value(1), "Start at the given block number (for benchmarking only, values > 1 will generate an unusable block log)");
     options.add_options()("block-count,n", boost::program_options::value<uint32_t>(), "Stop after this many blocks");
+    options.add_options()("train-dictionary", boost::program_options::bool_switch()->default_value(false), "Train a zstd dictionary on the blocks being compressed, store it next to the output block log and compress the range with it");
+    options.add_options()("dictionary-training-samples", boost::program_options::value<uint32_t>()->default_value(20000), "The number of blocks sampled for dictionary training");
+    options.add_options()("dictionary-size", boost::program_options::value<uint32_t>()->default_value(220 * 1024), "The target size of a trained dictionary in bytes");
     options.add_options()("use-compressed-even-when-larger", boost::program_options::bool_switch()->default_value(true), "Store the compressed version of the blocks, even when larger than the uncompressed version");
 
     options.add_options()("help,h", "Print usage instructions");
@@ -452,12 +647,32 @@ int main(int argc, char** argv)
     enable_zstd = !options_map["decompress"].as<bool>();
 
     zstd_level = options_map["zstd-level"].as<int>();
-    ilog("Compressing using zstd level ${zstd_level}", (zstd_level));
+    if (options_map.count("zstd-candidate-levels"))
+    {
+      zstd_candidate_levels = options_map["zstd-candidate-levels"].as<std::vector<int>>();
+      FC_ASSERT(!zstd_candidate_levels.empty(), "zstd-candidate-levels requires at least one level");
+      ilog("Compressing using best of zstd levels ${zstd_candidate_levels}", (zstd_candidate_levels));
+    }
+    else
+    {
+      zstd_candidate_levels.push_back(*zstd_level);
+      ilog("Compressing using zstd level ${zstd_level}", (zstd_level));
+    }
+    if (options_map.count("min-decompression-throughput"))
+      min_decompression_throughput = options_map["min-decompression-throughput"].as<uint32_t>();
+    level_selection_range = options_map["level-selection-range"].as<uint32_t>();
+    level_selection_samples = options_map["level-selection-samples"].as<uint32_t>();
+    level_selection_repeats = options_map["level-selection-repeats"].as<uint32_t>();
+    FC_ASSERT(level_selection_range && level_selection_samples && level_selection_repeats, "level selection parameters must be positive");
 
     benchmark_decompression = options_map.count("benchmark-decompression") > 0;
 
     unsigned jobs = options_map["jobs"].as<int>();
 
+    train_dictionary = options_map["train-dictionary"].as<bool>();
+    dictionary_training_samples = options_map["dictionary-training-samples"].as<uint32_t>();
+    dictionary_target_size = options_map["dictionary-size"].as<uint32_t>();
+
     starting_block_number = options_map["starting-block-number"].as<uint32_t>();
     if (options_map.count("block-count"))
       blocks_to_compress = options_map["block-count"].as<uint32_t>();
@@ -527,6 +742,15 @@ int main(int argc, char** argv)
     // we would have to attempt to compress the blocks each time we sent them to a peer.
     use_compressed_even_when_larger = options_map["use-compressed-even-when-larger"].as<bool>();
 
+    if (train_dictionary && enable_zstd)
+    {
+      hive::chain::load_local_zstd_compression_dictionaries(output_block_log_path.parent_path());
+      train_zstd_dictionary(input_block_log_path, input_readonly, output_block_log_path, theApp, thread_pool);
+    }
+
+    if (min_decompression_throughput && zstd_candidate_levels.size() > 1 && enable_zstd)
+      select_zstd_levels(input_block_log_path, input_readonly, theApp, thread_pool);
+
     do_job(input_block_log_path, output_block_log_path, jobs, input_readonly, theApp, thread_pool);
 
     if (error_detected.load())
@@ -542,6 +766,12 @@ int main(int argc, char** argv)
       ilog("    ${method}: ${count}", ("method", value.first)("count", value.second));
       total_blocks_processed += value.second;
     }
+    if (zstd_candidate_levels.size() > 1)
+    {
+      ilog("Number of zstd compressed blocks by chosen level:");
+      for (const auto& value : total_count_by_zstd_level)
+        ilog("    ${level}: ${count}", ("level", value.first)("count", value.second));
+    }
     ilog("Total bytes if all blocks compressed by compression method:");
     if (enable_zstd)
     {
@@ -28,6 +28,7 @@
 
 #include <hive/chain/database.hpp>
 #include <hive/chain/account_object.hpp>
+#include <hive/chain/authority_cache.hpp>
 #include <hive/chain/block_summary_object.hpp>
 #include <hive/chain/hive_objects.hpp>
 #include <hive/chain/dhf_objects.hpp>
@@ -38,6 +39,8 @@
 
 #include <hive/chain/util/decoded_types_data_storage.hpp>
 
+#include <hive/utilities/latency_histogram.hpp>
+
 #include <hive/protocol/hive_operations.hpp>
 #include <hive/protocol/protocol.hpp>
 #include <hive/protocol/transaction_util.hpp>
@@ -1926,6 +1929,42 @@ BOOST_AUTO_TEST_CASE( authorization_redirections )
 #undef CREATE_ACCOUNT
 }
 
+BOOST_AUTO_TEST_CASE( authority_cache_follows_state )
+{
+  ACTORS( (alice)(bob) );
+  generate_block();
+
+  auto get_witness_key = [&]( const std::string& name ) { try { return db->get_witness( name ).signing_key; } FC_CAPTURE_AND_RETHROW( ( name ) ) };
+  required_authorities_type required_authorities;
+  required_authorities.required_active.insert( "alice" );
+
+  hive::chain::authority_cache cache( *db );
+  const auto& alice_auth = db->get< account_authority_object, by_account >( "alice" );
+  const authority& cached_active = cache.get_active( "alice" );
+  BOOST_REQUIRE( cached_active == authority( alice_auth.active ) );
+  BOOST_REQUIRE_EQUAL( &cache.get_active( "alice" ), &cached_active );
+  BOOST_REQUIRE_EQUAL( cache.size(), 1u );
+  hive::protocol::verify_authority( true, false, required_authorities, { alice_private_key.get_public_key() }, cache, get_witness_key );
+
+  BOOST_TEST_MESSAGE( "--- cached authority follows modification and undo of account_authority_object" );
+  {
+    auto session = db->start_undo_session();
+    db->modify( alice_auth, [&]( account_authority_object& auth )
+    {
+      auth.active = authority( 1, "bob", 1 );
+    } );
+    BOOST_REQUIRE( cache.get_active( "alice" ) == authority( 1, "bob", 1 ) );
+    HIVE_REQUIRE_THROW( hive::protocol::verify_authority( true, false, required_authorities, { alice_private_key.get_public_key() }, cache, get_witness_key ), tx_missing_active_auth );
+    hive::protocol::verify_authority( true, false, required_authorities, { bob_private_key.get_public_key() }, cache, get_witness_key );
+    session.undo();
+  }
+  BOOST_REQUIRE( cache.get_active( "alice" ) == authority( alice_auth.active ) );
+  hive::protocol::verify_authority( true, false, required_authorities, { alice_private_key.get_public_key() }, cache, get_witness_key );
+
+  BOOST_TEST_MESSAGE( "--- unknown account is reported the same way as without cache" );
+  BOOST_REQUIRE_THROW( cache.get_owner( "nobody" ), std::out_of_range );
+}
+
 BOOST_AUTO_TEST_CASE( get_word_list )
 {
   auto word_list = hive::words::get_word_list();
@@ -1942,4 +1981,38 @@ BOOST_AUTO_TEST_CASE( get_word_list )
   BOOST_CHECK_EQUAL( word_list[hive::words::get_word_list_size()-1], "zythum" );
 }
 
+BOOST_AUTO_TEST_CASE( latency_histogram_percentiles )
+{
+  using hive::utilities::latency_histogram;
+
+  // every value lands in a bucket whose upper bound is not below it and is within 1/8 of it
+  for( uint64_t value : { 0ull, 1ull, 7ull, 8ull, 15ull, 16ull, 1000ull, 123456789ull, ( 1ull << 35 ) + 12345 } )
+  {
+    auto idx = latency_histogram::bucket_index( value );
+    BOOST_REQUIRE_LT( idx, latency_histogram::bucket_count );
+    BOOST_REQUIRE_GE( latency_histogram::bucket_upper_bound( idx ), value );
+    BOOST_REQUIRE_LE( latency_histogram::bucket_upper_bound( idx ) - value, value / latency_histogram::sub_bucket_count );
+  }
+  BOOST_REQUIRE_EQUAL( latency_histogram::bucket_index( uint64_t( -1 ) ), latency_histogram::bucket_count - 1 );
+
+  latency_histogram histogram;
+  for( uint64_t i = 1; i <= 1000; ++i )
+    histogram.record( i * 1000 );
+
+  auto data = histogram.take_snapshot();
+  BOOST_REQUIRE_EQUAL( data.count, 1000u );
+  BOOST_REQUIRE_EQUAL( data.max_ns, 1000000u );
+  BOOST_REQUIRE_EQUAL( data.total_ns, 500500000u );
+  BOOST_REQUIRE_GE( data.percentile( 50 ), 500000u );
+  BOOST_REQUIRE_LE( data.percentile( 50 ), 500000u + 500000u / 8 );
+  BOOST_REQUIRE_GE( data.percentile( 99 ), 990000u );
+  BOOST_REQUIRE_EQUAL( data.percentile( 100 ), 1000000u );
+
+  auto& stats = hive::utilities::latency_stats::instance();
+  BOOST_REQUIRE_EQUAL( &stats.get( "test", "latency_histogram_percentiles" ), &stats.get( "test", "latency_histogram_percentiles" ) );
+  stats.get( "test", "latency_histogram_percentiles" ).record( 2000 );
+  auto text = stats.to_prometheus_text();
+  BOOST_REQUIRE( text.find( "hived_latency_seconds_count{context=\"test\",name=\"latency_histogram_percentiles\"} 1" ) != std::string::npos );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
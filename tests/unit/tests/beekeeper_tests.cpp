@@ -735,6 +735,25 @@ BOOST_AUTO_TEST_CASE(wallet_manager_sign_transaction)
                             _signature_01_result );
 
       BOOST_REQUIRE_THROW( wm.sign_digest( _token, _wallet_name, "", beekeeper::utility::public_key::create( _imported_public_key, _prefix ), _prefix ), fc::exception );
+
+      {
+        BOOST_TEST_MESSAGE( "Signing many digests at once gives the same signatures as signing them one by one" );
+
+        std::vector<std::string> _sig_digests;
+        for( uint32_t i = 0; i < 100; ++i )
+          _sig_digests.emplace_back( fc::sha256::hash( std::to_string( i ) ).str() );
+
+        auto _signatures = wm.sign_digests( _token, _wallet_name, _sig_digests, beekeeper::utility::public_key::create( _imported_public_key, _prefix ), _prefix );
+        BOOST_REQUIRE_EQUAL( _signatures.size(), _sig_digests.size() );
+        for( size_t i = 0; i < _sig_digests.size(); ++i )
+          BOOST_REQUIRE( _signatures[i] == _private_key.sign_compact( fc::sha256( _sig_digests[i] ) ) );
+
+        auto _signatures_any_wallet = wm.sign_digests( _token, std::optional<std::string>(), { _sig_digests[0] }, beekeeper::utility::public_key::create( _imported_public_key, _prefix ), _prefix );
+        BOOST_REQUIRE( _signatures_any_wallet.size() == 1 && _signatures_any_wallet[0] == _signatures[0] );
+
+        BOOST_REQUIRE_THROW( wm.sign_digests( _token, _wallet_name, {}, beekeeper::utility::public_key::create( _imported_public_key, _prefix ), _prefix ), fc::exception );
+        BOOST_REQUIRE_THROW( wm.sign_digests( _token, _wallet_name, { _sig_digests[0], "" }, beekeeper::utility::public_key::create( _imported_public_key, _prefix ), _prefix ), fc::exception );
+      }
     }
 
   } FC_LOG_AND_RETHROW()
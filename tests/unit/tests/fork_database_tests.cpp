@@ -0,0 +1,280 @@
+#ifdef IS_TEST_NET
+#include <boost/test/unit_test.hpp>
+
+#include <hive/chain/database_exceptions.hpp>
+#include <hive/chain/fork_database.hpp>
+#include <hive/chain/full_block.hpp>
+
+#include <fc/crypto/elliptic.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace hive;
+using namespace hive::chain;
+using namespace hive::protocol;
+
+namespace
+{
+  // builds an empty block on top of given previous block; different forks produce different block ids
+  std::shared_ptr<full_block_type> make_fork_db_test_block( const block_id_type& previous, uint32_t fork )
+  {
+    block_header header;
+    header.previous = previous;
+    header.timestamp = fc::time_point_sec( 1514764800 + 3 * ( block_header::num_from_id( previous ) + 1 ) );
+    header.witness = "witness" + std::to_string( fork );
+    const fc::ecc::private_key signer = fc::ecc::private_key::regenerate( fc::sha256::hash( std::string( "fork_database" ) ) );
+    return full_block_type::create_from_block_header_and_transactions( header, {}, &signer );
+  }
+
+  // collects given block and all its ancestors by following prev links (in descending order)
+  std::vector<item_ptr> walk_prev_links( const item_ptr& item )
+  {
+    std::vector<item_ptr> result;
+    for( item_ptr next = item; next; next = next->prev.lock() )
+      result.push_back( next );
+    return result;
+  }
+
+  // same algorithm as original get_blockchain_synopsis, computed on a branch collected with walk_prev_links
+  std::vector<block_id_type> make_expected_synopsis( const std::vector<item_ptr>& branch, uint32_t last_irreversible_block_num,
+    uint32_t number_of_blocks_after_reference_point )
+  {
+    std::vector<block_id_type> synopsis;
+    const uint32_t reference_point_block_num = branch.front()->get_block_num();
+    const uint32_t true_high_block_num = reference_point_block_num + number_of_blocks_after_reference_point;
+    uint32_t low_block_num = last_irreversible_block_num ? last_irreversible_block_num : 1;
+    do
+    {
+      synopsis.push_back( branch[ reference_point_block_num - low_block_num ]->get_block_id() );
+      low_block_num += ( true_high_block_num - low_block_num + 2 ) / 2;
+    }
+    while( low_block_num <= reference_point_block_num );
+    return synopsis;
+  }
+
+  // compares main branch queries of fork database with results of walking prev links from its head
+  void check_main_branch( const fork_database& fork_db )
+  {
+    const item_ptr head = fork_db.head();
+    fc::optional<uint32_t> block_number_needed_from_block_log;
+    if( !head )
+    {
+      BOOST_REQUIRE( !fork_db.fetch_block_on_main_branch_by_number( 1 ) );
+      BOOST_REQUIRE( fork_db.get_blockchain_synopsis( block_id_type(), 0, block_number_needed_from_block_log ).empty() );
+      return;
+    }
+
+    const std::vector<item_ptr> main_branch = walk_prev_links( head );
+    const uint32_t head_num = head->get_block_num();
+    const uint32_t oldest_linked_num = main_branch.back()->get_block_num();
+    const uint32_t last_irreversible_block_num = fork_db.get_last_irreversible_block_num();
+
+    for( uint32_t num = 1; num <= head_num + 1; ++num )
+    {
+      const item_ptr expected = ( num >= oldest_linked_num && num <= head_num ) ? main_branch[ head_num - num ] : item_ptr();
+      BOOST_REQUIRE( fork_db.walk_main_branch_to_num( num ) == expected );
+
+      const item_ptr actual = fork_db.fetch_block_on_main_branch_by_number( num );
+      if( expected )
+      {
+        BOOST_REQUIRE( actual == expected );
+      }
+      else if( actual )
+      {
+        // blocks not reachable from head can only be returned when they are the only ones with given number
+        const std::vector<item_ptr> blocks = fork_db.fetch_block_by_number( num );
+        BOOST_REQUIRE_EQUAL( blocks.size(), 1u );
+        BOOST_REQUIRE( blocks.front() == actual );
+      }
+
+      const std::vector<fork_item> range = fork_db.fetch_block_range_on_main_branch_by_number( num, 4 );
+      std::vector<block_id_type> expected_range;
+      const uint32_t last_num = std::min( num + 3, head_num );
+      if( last_num >= oldest_linked_num && num <= head_num )
+      {
+        for( uint32_t range_num = std::max( num, oldest_linked_num ); range_num <= last_num; ++range_num )
+          expected_range.push_back( main_branch[ head_num - range_num ]->get_block_id() );
+      }
+      BOOST_REQUIRE_EQUAL( range.size(), expected_range.size() );
+      for( size_t i = 0; i < range.size(); ++i )
+        BOOST_REQUIRE( range[i].full_block->get_block_id() == expected_range[i] );
+    }
+
+    // synopsis for head and for every block (on any fork) that still links back to last irreversible block
+    if( oldest_linked_num == last_irreversible_block_num )
+    {
+      for( uint32_t number_of_blocks_after_reference_point : { 0u, 5u } )
+      {
+        BOOST_REQUIRE( fork_db.get_blockchain_synopsis( block_id_type(), number_of_blocks_after_reference_point, block_number_needed_from_block_log ) ==
+          make_expected_synopsis( main_branch, last_irreversible_block_num, number_of_blocks_after_reference_point ) );
+      }
+    }
+    for( uint32_t num = last_irreversible_block_num; num <= head_num; ++num )
+    {
+      for( const item_ptr& reference_point : fork_db.fetch_block_by_number( num ) )
+      {
+        const std::vector<item_ptr> branch = walk_prev_links( reference_point );
+        if( branch.back()->get_block_num() != last_irreversible_block_num )
+          continue;
+        for( uint32_t number_of_blocks_after_reference_point : { 0u, 5u } )
+        {
+          BOOST_REQUIRE( fork_db.get_blockchain_synopsis( reference_point->get_block_id(), number_of_blocks_after_reference_point, block_number_needed_from_block_log ) ==
+            make_expected_synopsis( branch, last_irreversible_block_num, number_of_blocks_after_reference_point ) );
+          BOOST_REQUIRE( !block_number_needed_from_block_log.valid() );
+        }
+      }
+    }
+  }
+
+  // pushes blocks of given fork on top of given block, returns id of last one
+  block_id_type push_fork_db_test_blocks( fork_database& fork_db, block_id_type previous, uint32_t count, uint32_t fork )
+  {
+    for( uint32_t i = 0; i < count; ++i )
+    {
+      auto full_block = make_fork_db_test_block( previous, fork );
+      fork_db.push_block( full_block );
+      previous = full_block->get_block_id();
+      check_main_branch( fork_db );
+    }
+    return previous;
+  }
+}
+
+BOOST_AUTO_TEST_SUITE( fork_database_tests )
+
+BOOST_AUTO_TEST_CASE( main_branch_after_push_pop_and_fork_switch )
+{
+  try
+  {
+    fork_database fork_db;
+    check_main_branch( fork_db );
+
+    BOOST_TEST_MESSAGE( "Starting main branch" );
+    auto first_block = make_fork_db_test_block( block_id_type(), 0 );
+    fork_db.start_block( first_block );
+    check_main_branch( fork_db );
+    const block_id_type main_head_id = push_fork_db_test_blocks( fork_db, first_block->get_block_id(), 9, 0 );
+    BOOST_REQUIRE_EQUAL( fork_db.head()->get_block_num(), 10u );
+    const block_id_type main_block_6_id = fork_db.fetch_block_on_main_branch_by_number( 6 )->get_block_id();
+
+    BOOST_TEST_MESSAGE( "Pushing shorter fork, head should stay" );
+    push_fork_db_test_blocks( fork_db, main_block_6_id, 3, 1 );
+    BOOST_REQUIRE( fork_db.head()->get_block_id() == main_head_id );
+
+    BOOST_TEST_MESSAGE( "Extending fork past main branch, head should switch" );
+    item_ptr fork_tip;
+    for( const item_ptr& item : fork_db.fetch_block_by_number( 9 ) )
+      if( item->get_block_id() != fork_db.fetch_block_on_main_branch_by_number( 9 )->get_block_id() )
+        fork_tip = item;
+    BOOST_REQUIRE( fork_tip );
+    const block_id_type fork_head_id = push_fork_db_test_blocks( fork_db, fork_tip->get_block_id(), 2, 1 );
+    BOOST_REQUIRE( fork_db.head()->get_block_id() == fork_head_id );
+    BOOST_REQUIRE_EQUAL( fork_db.head()->get_block_num(), 11u );
+
+    BOOST_TEST_MESSAGE( "Popping blocks" );
+    fork_db.pop_block();
+    check_main_branch( fork_db );
+    fork_db.pop_block();
+    check_main_branch( fork_db );
+    BOOST_REQUIRE( fork_db.head() == fork_tip );
+
+    BOOST_TEST_MESSAGE( "Switching head back to original branch" );
+    fork_db.set_head( fork_db.fetch_block( main_head_id ) );
+    check_main_branch( fork_db );
+    BOOST_REQUIRE( fork_db.fetch_block_on_main_branch_by_number( 6 )->get_block_id() == main_block_6_id );
+    fork_db.set_head( fork_tip );
+    check_main_branch( fork_db );
+    fork_db.set_head( fork_db.fetch_block( main_head_id ) );
+    check_main_branch( fork_db );
+
+    BOOST_TEST_MESSAGE( "Linking out of order blocks from another fork" );
+    const block_id_type main_block_7_id = fork_db.fetch_block_on_main_branch_by_number( 7 )->get_block_id();
+    std::vector<std::shared_ptr<full_block_type>> other_fork;
+    block_id_type previous = main_block_7_id;
+    for( uint32_t i = 0; i < 5; ++i )
+    {
+      other_fork.push_back( make_fork_db_test_block( previous, 2 ) );
+      previous = other_fork.back()->get_block_id();
+    }
+    BOOST_REQUIRE_THROW( fork_db.push_block( other_fork.back() ), unlinkable_block_exception );
+    check_main_branch( fork_db );
+    for( size_t i = 0; i + 1 < other_fork.size(); ++i )
+    {
+      fork_db.push_block( other_fork[i] );
+      check_main_branch( fork_db );
+    }
+    BOOST_REQUIRE( fork_db.head()->get_block_id() == other_fork.back()->get_block_id() );
+    BOOST_REQUIRE_EQUAL( fork_db.head()->get_block_num(), 12u );
+  }
+  FC_LOG_AND_RETHROW()
+}
+
+BOOST_AUTO_TEST_CASE( main_branch_after_remove_prune_and_reset )
+{
+  try
+  {
+    fork_database fork_db;
+    auto first_block = make_fork_db_test_block( block_id_type(), 0 );
+    fork_db.start_block( first_block );
+    const block_id_type main_head_id = push_fork_db_test_blocks( fork_db, first_block->get_block_id(), 9, 0 );
+    const block_id_type main_block_5_id = fork_db.fetch_block_on_main_branch_by_number( 5 )->get_block_id();
+    const block_id_type fork_head_id = push_fork_db_test_blocks( fork_db, main_block_5_id, 7, 1 );
+    BOOST_REQUIRE( fork_db.head()->get_block_id() == fork_head_id );
+    BOOST_REQUIRE_EQUAL( fork_db.head()->get_block_num(), 12u );
+
+    BOOST_TEST_MESSAGE( "Removing head block" );
+    fork_db.remove( fork_head_id );
+    check_main_branch( fork_db );
+    BOOST_REQUIRE_EQUAL( fork_db.head()->get_block_num(), 11u );
+
+    BOOST_TEST_MESSAGE( "Removing block from the middle of main branch" );
+    // removed block is still held by the caller during remove()
+    fork_db.remove( fork_db.fetch_block_on_main_branch_by_number( 8 )->get_block_id() );
+    check_main_branch( fork_db );
+
+    BOOST_TEST_MESSAGE( "Removing block outside of main branch" );
+    fork_db.set_head( fork_db.fetch_block( main_head_id ) );
+    check_main_branch( fork_db );
+    for( const item_ptr& item : fork_db.fetch_block_by_number( 7 ) )
+      if( item != fork_db.fetch_block_on_main_branch_by_number( 7 ) )
+        fork_db.remove( item->get_block_id() );
+    check_main_branch( fork_db );
+    BOOST_REQUIRE_EQUAL( fork_db.fetch_block_by_number( 7 ).size(), 1u );
+
+    BOOST_TEST_MESSAGE( "Pruning old blocks" );
+    fork_db.set_max_size( 5 );
+    check_main_branch( fork_db );
+    BOOST_REQUIRE_EQUAL( fork_db.get_last_irreversible_block_num(), 6u );
+    block_id_type previous = main_head_id;
+    for( uint32_t i = 0; i < 5; ++i )
+    {
+      auto full_block = make_fork_db_test_block( previous, 0 );
+      fork_db.push_block( full_block );
+      fork_db.set_max_size( 5 );
+      check_main_branch( fork_db );
+      previous = full_block->get_block_id();
+    }
+    BOOST_REQUIRE_EQUAL( fork_db.get_last_irreversible_block_num(), 11u );
+    BOOST_REQUIRE( !fork_db.fetch_block_on_main_branch_by_number( 10 ) );
+    fork_db.set_max_size( 2 );
+    check_main_branch( fork_db );
+    BOOST_REQUIRE_EQUAL( fork_db.get_last_irreversible_block_num(), 14u );
+    fork_db.set_max_size( 1024 );
+    push_fork_db_test_blocks( fork_db, fork_db.fetch_block_on_main_branch_by_number( 14 )->get_block_id(), 3, 1 );
+
+    BOOST_TEST_MESSAGE( "Resetting" );
+    fork_db.reset();
+    check_main_branch( fork_db );
+    auto restart_block = make_fork_db_test_block( previous, 3 );
+    fork_db.start_block( restart_block );
+    check_main_branch( fork_db );
+    push_fork_db_test_blocks( fork_db, restart_block->get_block_id(), 3, 3 );
+    BOOST_REQUIRE_EQUAL( fork_db.get_last_irreversible_block_num(), 16u );
+    BOOST_REQUIRE( fork_db.fetch_block_on_main_branch_by_number( 16 )->get_block_id() == restart_block->get_block_id() );
+  }
+  FC_LOG_AND_RETHROW()
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+#endif
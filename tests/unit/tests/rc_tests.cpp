@@ -882,6 +882,97 @@ BOOST_AUTO_TEST_CASE( rc_tx_order_bug )
   FC_LOG_AND_RETHROW()
 }
 
+BOOST_AUTO_TEST_CASE( rc_drained_payer_pending_reapply )
+{
+  try
+  {
+    BOOST_TEST_MESSAGE( "Testing that pending transactions of payer that ran out of RC are not lost when reapplied" );
+
+    inject_hardfork( HIVE_BLOCKCHAIN_VERSION.minor_v() );
+    configuration_data.allow_not_enough_rc = false;
+
+    ACTORS( (alice)(bob) )
+    generate_block();
+    vest( "alice", ASSET( "10000.000 TESTS" ) );
+    issue_funds( "alice", ASSET( "1000.000 TESTS" ) );
+    generate_blocks( 20 );
+
+    const auto& alice_rc = db->get_account( "alice" );
+    const auto claimed_before = alice_rc.pending_claimed_accounts;
+
+    BOOST_TEST_MESSAGE( "Save aside and remove empty head block - pushing it again will reapply pending transactions" );
+    generate_block();
+    auto block = get_block_reader().get_block_by_number( db->head_block_num() );
+    BOOST_REQUIRE( block );
+    db->pop_block();
+
+    BOOST_TEST_MESSAGE( "Put two expensive claims and cheap but bigger transfer of alice to pending" );
+    //mana of alice is set by artificial transaction that is pending before others, so it is set again on reapplication
+    int64_t alice_mana = alice_rc.get_maximum_rc().value;
+    db_plugin->debug_update( [&]( database& db )
+    {
+      db.modify( db.get_account( "alice" ), [&]( account_object& account )
+      {
+        account.rc_manabar.current_mana = alice_mana;
+        account.rc_manabar.last_update_time = db.head_block_time().sec_since_epoch();
+      } );
+    } );
+
+    signed_transaction claim1, claim2, transfer_tx;
+    claim_account_operation claim;
+    claim.creator = "alice";
+    claim.fee = ASSET( "0.000 TESTS" );
+    claim1.set_expiration( db->head_block_time() + HIVE_MAX_TIME_UNTIL_EXPIRATION );
+    claim1.operations.push_back( claim );
+    claim2.set_expiration( db->head_block_time() + HIVE_MAX_TIME_UNTIL_EXPIRATION - HIVE_BLOCK_INTERVAL );
+    claim2.operations.push_back( claim );
+    transfer_operation transfer;
+    transfer.from = "alice";
+    transfer.to = "bob";
+    transfer.amount = ASSET( "1.000 TESTS" );
+    transfer.memo = std::string( 500, 'x' );
+    transfer_tx.set_expiration( db->head_block_time() + HIVE_MAX_TIME_UNTIL_EXPIRATION );
+    transfer_tx.operations.push_back( transfer );
+    auto claim1_full = push_transaction( claim1, alice_private_key );
+    auto claim2_full = push_transaction( claim2, alice_private_key );
+    auto transfer_full = push_transaction( transfer_tx, alice_private_key );
+    const int64_t claim_cost = claim1_full->get_rc_cost();
+    const int64_t transfer_cost = transfer_full->get_rc_cost();
+    //transfer is bigger but cheaper - RC cost depends on operation types more than on transaction size
+    BOOST_REQUIRE_GT( transfer_full->get_transaction_size(), claim2_full->get_transaction_size() );
+    BOOST_REQUIRE_GT( claim_cost, transfer_cost );
+    BOOST_REQUIRE_EQUAL( alice_rc.pending_claimed_accounts.value, claimed_before.value + 2 );
+    BOOST_REQUIRE( get_balance( "alice" ) == ASSET( "999.000 TESTS" ) );
+
+    auto is_pending = [&]( const full_transaction_ptr& tx )
+    {
+      return std::find( db->_pending_tx.begin(), db->_pending_tx.end(), tx ) != db->_pending_tx.end();
+    };
+
+    BOOST_TEST_MESSAGE( "Push previously popped block with alice having enough RC for the transfer but not for a claim" );
+    alice_mana = transfer_cost + ( claim_cost - transfer_cost ) / 2;
+    push_block( block );
+    //first claim failed and was dropped, second one costs as much so it was postponed without execution,
+    //transfer costs less so it was executed despite alice being drained
+    BOOST_REQUIRE( !is_pending( claim1_full ) );
+    BOOST_REQUIRE( is_pending( claim2_full ) );
+    BOOST_REQUIRE( is_pending( transfer_full ) );
+    BOOST_REQUIRE_EQUAL( alice_rc.pending_claimed_accounts.value, claimed_before.value );
+    BOOST_REQUIRE( get_balance( "alice" ) == ASSET( "999.000 TESTS" ) );
+    BOOST_REQUIRE( get_balance( "bob" ) == ASSET( "1.000 TESTS" ) );
+
+    BOOST_TEST_MESSAGE( "Postponed claim is included in next block once alice has enough RC" );
+    alice_mana = alice_rc.get_maximum_rc().value;
+    generate_block();
+    BOOST_REQUIRE_EQUAL( alice_rc.pending_claimed_accounts.value, claimed_before.value + 1 );
+    BOOST_REQUIRE( get_balance( "alice" ) == ASSET( "999.000 TESTS" ) );
+    BOOST_REQUIRE( get_balance( "bob" ) == ASSET( "1.000 TESTS" ) );
+
+    validate_database();
+  }
+  FC_LOG_AND_RETHROW()
+}
+
 BOOST_AUTO_TEST_CASE( rc_pending_data_reset )
 {
   try
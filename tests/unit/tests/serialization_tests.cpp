@@ -28,6 +28,7 @@
 
 #include <hive/chain/hive_objects.hpp>
 #include <hive/chain/database.hpp>
+#include <hive/chain/full_block.hpp>
 
 #include <hive/protocol/asset.hpp>
 #include <hive/plugins/condenser_api/condenser_api_legacy_objects.hpp>
@@ -36,6 +37,9 @@
 #include <fc/crypto/elliptic.hpp>
 #include <fc/reflect/variant.hpp>
 
+#include <graphene/net/core_messages.hpp>
+#include <graphene/net/message.hpp>
+
 #include "../db_fixture/clean_database_fixture.hpp"
 
 #include <cmath>
@@ -904,5 +908,114 @@ R"([{
   FC_LOG_AND_RETHROW();
 }
 
+
+namespace
+{
+  full_transaction_ptr make_compact_block_test_transaction( const std::string& permlink, bool use_transaction_cache )
+  {
+    vote_operation op;
+    op.voter = "alice";
+    op.author = "bob";
+    op.permlink = permlink;
+    op.weight = HIVE_100_PERCENT;
+
+    signed_transaction tx;
+    tx.ref_block_num = 4000;
+    tx.ref_block_prefix = 4000000000;
+    tx.expiration = fc::time_point_sec( 1514764800 );
+    tx.operations.push_back( op );
+    return full_transaction_type::create_from_signed_transaction( tx, hive::protocol::pack_type::hf26, use_transaction_cache );
+  }
+
+  std::shared_ptr<full_block_type> make_compact_block_test_block( const std::vector<full_transaction_ptr>& transactions )
+  {
+    block_header header;
+    header.timestamp = fc::time_point_sec( 1514764800 );
+    header.witness = "initminer";
+    const fc::ecc::private_key signer = fc::ecc::private_key::regenerate( fc::sha256::hash( std::string( "compact_block" ) ) );
+    return full_block_type::create_from_block_header_and_transactions( header, transactions, &signer );
+  }
+}
+
+BOOST_AUTO_TEST_CASE( compact_block_message_round_trip )
+{
+  try
+  {
+    // transactions are only weakly referenced by the cache, keep them alive for the whole test
+    std::vector<full_transaction_ptr> transactions;
+    for( int i = 0; i < 4; ++i )
+      transactions.push_back( make_compact_block_test_transaction( "compact-round-trip-" + std::to_string( i ), true ) );
+    const auto full_block = make_compact_block_test_block( transactions );
+
+    // peer is supposed to know transactions 0 and 2, the other two go in full
+    const std::set<digest_type> known_digests = { transactions[0]->get_merkle_digest(), transactions[2]->get_merkle_digest() };
+    const graphene::net::compact_block_message compact_block( full_block, [&]( const full_transaction_type& tx )
+      { return known_digests.count( tx.get_merkle_digest() ) != 0; } );
+
+    BOOST_REQUIRE_EQUAL( compact_block.short_transaction_ids.size(), 2u );
+    BOOST_REQUIRE_EQUAL( compact_block.prefilled_transactions.size(), 2u );
+    BOOST_CHECK_EQUAL( compact_block.prefilled_transactions[0].index, 1u );
+    BOOST_CHECK_EQUAL( compact_block.prefilled_transactions[1].index, 3u );
+
+    const graphene::net::message msg( compact_block );
+    BOOST_REQUIRE_EQUAL( msg.msg_type, uint32_t( graphene::net::compact_block_message_type ) );
+    const graphene::net::compact_block_message unpacked = msg.as< graphene::net::compact_block_message >();
+
+    BOOST_CHECK( full_block_type::compute_block_id( unpacked.header ) == full_block->get_block_id() );
+    BOOST_CHECK( unpacked.header.witness_signature == full_block->get_block_header().witness_signature );
+    BOOST_CHECK( unpacked.short_transaction_ids == compact_block.short_transaction_ids );
+    BOOST_REQUIRE_EQUAL( unpacked.prefilled_transactions.size(), compact_block.prefilled_transactions.size() );
+    for( size_t i = 0; i < unpacked.prefilled_transactions.size(); ++i )
+    {
+      BOOST_CHECK_EQUAL( unpacked.prefilled_transactions[i].index, compact_block.prefilled_transactions[i].index );
+      BOOST_CHECK( unpacked.prefilled_transactions[i].serialized_transaction == compact_block.prefilled_transactions[i].serialized_transaction );
+    }
+  }
+  FC_LOG_AND_RETHROW();
+}
+
+BOOST_AUTO_TEST_CASE( compact_block_rebuild )
+{
+  try
+  {
+    std::vector<full_transaction_ptr> transactions;
+    for( int i = 0; i < 4; ++i )
+      transactions.push_back( make_compact_block_test_transaction( "compact-rebuild-" + std::to_string( i ), true ) );
+    const auto full_block = make_compact_block_test_block( transactions );
+
+    const std::set<digest_type> known_digests = { transactions[0]->get_merkle_digest(), transactions[2]->get_merkle_digest() };
+    const graphene::net::compact_block_message compact_block( full_block, [&]( const full_transaction_type& tx )
+      { return known_digests.count( tx.get_merkle_digest() ) != 0; } );
+
+    BOOST_TEST_MESSAGE( "All transactions available - block is rebuilt with the same id and merkle root" );
+    uint32_t missing_transaction_count = 0;
+    const auto rebuilt_block = compact_block.rebuild_block( missing_transaction_count );
+    BOOST_REQUIRE( rebuilt_block );
+    BOOST_CHECK_EQUAL( missing_transaction_count, 0u );
+    BOOST_CHECK( rebuilt_block->get_block_id() == full_block->get_block_id() );
+    BOOST_CHECK( rebuilt_block->get_merkle_root() == full_block->get_block_header().transaction_merkle_root );
+    BOOST_CHECK_EQUAL( rebuilt_block->get_full_transactions().size(), transactions.size() );
+
+    BOOST_TEST_MESSAGE( "Short ids resolving to wrong transactions - merkle root check rejects the block" );
+    graphene::net::compact_block_message swapped = compact_block;
+    std::swap( swapped.short_transaction_ids[0], swapped.short_transaction_ids[1] );
+    BOOST_CHECK( !swapped.rebuild_block( missing_transaction_count ) );
+    BOOST_CHECK_EQUAL( missing_transaction_count, 0u );
+
+    BOOST_TEST_MESSAGE( "Transaction not in the cache - counted as missing" );
+    const full_transaction_ptr unknown_transaction = make_compact_block_test_transaction( "compact-rebuild-unknown", false );
+    graphene::net::compact_block_message with_unknown = compact_block;
+    with_unknown.short_transaction_ids[1] = graphene::net::compact_block_message::get_short_transaction_id( unknown_transaction->get_merkle_digest() );
+    BOOST_CHECK( !with_unknown.rebuild_block( missing_transaction_count ) );
+    BOOST_CHECK_EQUAL( missing_transaction_count, 1u );
+
+    BOOST_TEST_MESSAGE( "Malformed message - prefilled index out of range" );
+    graphene::net::compact_block_message malformed = compact_block;
+    malformed.prefilled_transactions[1].index = transactions.size();
+    BOOST_CHECK_THROW( malformed.rebuild_block( missing_transaction_count ), fc::exception );
+  }
+  FC_LOG_AND_RETHROW();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 #endif
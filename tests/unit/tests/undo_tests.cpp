@@ -20,6 +20,8 @@
 #include "../undo_data/undo.hpp"
 
 #include <cmath>
+#include <map>
+#include <random>
 #include <iostream>
 #include <stdexcept>
 
@@ -1402,6 +1404,153 @@ BOOST_AUTO_TEST_CASE( undo_state_on_squash_and_undo_with_keep_alive )
   FC_LOG_AND_RETHROW()
 }
 
+BOOST_AUTO_TEST_CASE( undo_state_randomized )
+{
+  try
+  {
+    BOOST_TEST_MESSAGE( "--- Testing undo state against model with random create/modify/remove/undo/squash/commit" );
+
+    generate_blocks( 2 * HIVE_MAX_WITNESSES );
+    db->commit( db->revision() );
+    db->clear_pending();
+    auto time = db->head_block_time();
+
+    auto& index = db->get_index< transaction_index >();
+    const auto& by_id_idx = db->get_index< transaction_index, by_id >();
+
+    // expected state of the index: objects by id and next id; the stack holds states from before each open session
+    struct model_state
+    {
+      std::map< transaction_object_id_type, std::pair< transaction_id_type, time_point_sec > > objects;
+      transaction_object_id_type next_id;
+    };
+    model_state model;
+    for( const auto& transaction : by_id_idx )
+      model.objects.emplace( transaction.get_id(), std::make_pair( transaction.trx_id, transaction.expiration ) );
+    model.next_id = index.get_next_id();
+    std::vector< model_state > model_stack;
+
+    const size_t MAX_DEPTH = 6;
+    std::vector< chainbase::database::undo_session_guard > sessions;
+    sessions.reserve( MAX_DEPTH );
+
+    auto check = [&]( int step )
+    {
+      BOOST_REQUIRE_MESSAGE( by_id_idx.size() == model.objects.size(), "size mismatch in step " << step );
+      BOOST_REQUIRE_MESSAGE( index.get_next_id() == model.next_id, "next_id mismatch in step " << step );
+      auto model_itr = model.objects.begin();
+      for( const auto& transaction : by_id_idx )
+      {
+        BOOST_REQUIRE_MESSAGE( transaction.get_id() == model_itr->first, "id mismatch in step " << step );
+        BOOST_REQUIRE_MESSAGE( transaction.trx_id == model_itr->second.first, "trx_id mismatch in step " << step );
+        BOOST_REQUIRE_MESSAGE( transaction.expiration == model_itr->second.second, "expiration mismatch in step " << step );
+        ++model_itr;
+      }
+    };
+
+    auto pick = [&]( uint32_t r ) -> transaction_object_id_type
+    {
+      auto itr = model.objects.begin();
+      std::advance( itr, r % model.objects.size() );
+      return itr->first;
+    };
+
+    std::mt19937 generator( 20231 );
+    uint32_t seed = 0;
+    const int STEPS = 20000;
+    for( int step = 0; step < STEPS; ++step )
+    {
+      uint32_t r = generator();
+      switch( r % 16 )
+      {
+        case 0: case 1: case 2: case 3:
+        {
+          const auto& transaction = db->create< transaction_object >( [&]( transaction_object& t )
+          {
+            t.trx_id = transaction_id_type::hash( "random" + std::to_string( seed++ ) );
+            t.expiration = time + ( generator() % 1000 );
+          } );
+          BOOST_REQUIRE( transaction.get_id() == model.next_id );
+          model.objects.emplace( transaction.get_id(), std::make_pair( transaction.trx_id, transaction.expiration ) );
+          ++model.next_id;
+          break;
+        }
+        case 4: case 5: case 6:
+        {
+          if( model.objects.empty() )
+            break;
+          auto id = pick( generator() );
+          time_point_sec expiration = time + ( generator() % 1000 );
+          db->modify( index.get( id ), [&]( transaction_object& t ) { t.expiration = expiration; } );
+          model.objects[ id ].second = expiration;
+          break;
+        }
+        case 7: case 8:
+        {
+          if( model.objects.empty() )
+            break;
+          auto id = pick( generator() );
+          db->remove( index.get( id ) );
+          model.objects.erase( id );
+          break;
+        }
+        case 9: case 10:
+        {
+          if( sessions.size() == MAX_DEPTH )
+            break;
+          sessions.emplace_back( db->start_undo_session() );
+          model_stack.push_back( model );
+          break;
+        }
+        case 11: case 12:
+        {
+          if( sessions.empty() )
+            break;
+          sessions.back().undo();
+          sessions.pop_back();
+          model = model_stack.back();
+          model_stack.pop_back();
+          check( step );
+          break;
+        }
+        case 13: case 14:
+        {
+          // squash merges into the underlying session, the bottom one is only pushed and committed (below)
+          if( sessions.size() < 2 )
+            break;
+          sessions.back().squash();
+          sessions.pop_back();
+          model_stack.pop_back();
+          check( step );
+          break;
+        }
+        case 15:
+        {
+          if( sessions.size() != 1 )
+            break;
+          sessions.back().push();
+          sessions.pop_back();
+          db->commit( db->revision() );
+          model_stack.clear();
+          check( step );
+          break;
+        }
+      }
+    }
+    check( STEPS );
+
+    while( !sessions.empty() )
+    {
+      sessions.back().undo();
+      sessions.pop_back();
+      model = model_stack.back();
+      model_stack.pop_back();
+      check( STEPS );
+    }
+  }
+  FC_LOG_AND_RETHROW()
+}
+
 BOOST_AUTO_TEST_CASE( empty_undo_benchmark )
 {
   try
@@ -1748,7 +1897,7 @@ BOOST_AUTO_TEST_CASE( filled_undo_benchmark )
 
     const int NUMBER_OF_OBJECTS = 30000;
 
-    // create big objects with subcontainers: account_object (place on undo_state::new_ids)
+    // create big objects with subcontainers: account_object (new objects, id at or above undo_state::old_next_id)
     {
       auto undo_session = db->start_undo_session();
       auto time_start = std::chrono::high_resolution_clock::now();
@@ -1762,16 +1911,16 @@ BOOST_AUTO_TEST_CASE( filled_undo_benchmark )
         ( "x", NUMBER_OF_OBJECTS )( "t", duration_ns )( "o", ( duration_ns + NUMBER_OF_OBJECTS - 1 ) / NUMBER_OF_OBJECTS ) );
       BOOST_REQUIRE_EQUAL( account_idx.size(), account_idx_size + NUMBER_OF_OBJECTS );
 
-      // remove big objects from undo session through undo (they are on new_ids, so their size does not matter)
+      // remove big objects from undo session through undo (they are new, so their size does not matter)
       time_start = std::chrono::high_resolution_clock::now();
       undo_session.undo();
       duration_ns = std::chrono::duration_cast< std::chrono::nanoseconds >( std::chrono::high_resolution_clock::now() - time_start ).count();
-      ilog( "Removing of ${x} new account_objects from new_ids through undo took ${t}ns (${o} per object)",
+      ilog( "Removing of ${x} new account_objects through undo took ${t}ns (${o} per object)",
         ( "x", NUMBER_OF_OBJECTS )( "t", duration_ns )( "o", ( duration_ns + NUMBER_OF_OBJECTS - 1 ) / NUMBER_OF_OBJECTS ) );
       BOOST_REQUIRE_EQUAL( account_idx.size(), account_idx_size );
     }
 
-    // create big objects again (place on undo_state::new_ids)
+    // create big objects again (new objects, id at or above undo_state::old_next_id)
     {
       auto undo_session = db->start_undo_session();
       auto time_start = std::chrono::high_resolution_clock::now();
@@ -1785,12 +1934,12 @@ BOOST_AUTO_TEST_CASE( filled_undo_benchmark )
         ( "x", NUMBER_OF_OBJECTS )( "t", duration_ns )( "o", ( duration_ns + NUMBER_OF_OBJECTS - 1 ) / NUMBER_OF_OBJECTS ) );
       BOOST_REQUIRE_EQUAL( account_idx.size(), account_idx_size + NUMBER_OF_OBJECTS );
 
-      // remove big objects from undo session through commit (they are on new_ids, so their size does not matter)
+      // remove big objects from undo session through commit (they are new, so their size does not matter)
       time_start = std::chrono::high_resolution_clock::now();
       undo_session.push();
       db->commit( db->revision() );
       duration_ns = std::chrono::duration_cast< std::chrono::nanoseconds >( std::chrono::high_resolution_clock::now() - time_start ).count();
-      ilog( "Removing of ${x} new account_objects from new_ids through commit took ${t}ns (${o} per object)",
+      ilog( "Removing of ${x} new account_objects through commit took ${t}ns (${o} per object)",
         ( "x", NUMBER_OF_OBJECTS )( "t", duration_ns )( "o", ( duration_ns + NUMBER_OF_OBJECTS - 1 ) / NUMBER_OF_OBJECTS ) );
       BOOST_REQUIRE_EQUAL( account_idx.size(), account_idx_size + NUMBER_OF_OBJECTS );
     }
@@ -1799,7 +1948,7 @@ BOOST_AUTO_TEST_CASE( filled_undo_benchmark )
     auto firstAccountI = lastBuiltinAccountI;
     ++firstAccountI;
 
-    // create small objects: comment_object (place on undo_state::new_ids)
+    // create small objects: comment_object (new objects, id at or above undo_state::old_next_id)
     {
       auto undo_session = db->start_undo_session();
       auto time_start = std::chrono::high_resolution_clock::now();
@@ -1812,16 +1961,16 @@ BOOST_AUTO_TEST_CASE( filled_undo_benchmark )
         ( "x", NUMBER_OF_OBJECTS )( "t", duration_ns )( "o", ( duration_ns + NUMBER_OF_OBJECTS - 1 ) / NUMBER_OF_OBJECTS ) );
       BOOST_REQUIRE_EQUAL( comment_idx.size(), comment_idx_size + NUMBER_OF_OBJECTS );
 
-      // remove small objects from undo session through undo (they are on new_ids, so their size does not matter)
+      // remove small objects from undo session through undo (they are new, so their size does not matter)
       time_start = std::chrono::high_resolution_clock::now();
       undo_session.undo();
       duration_ns = std::chrono::duration_cast< std::chrono::nanoseconds >( std::chrono::high_resolution_clock::now() - time_start ).count();
-      ilog( "Removing of ${x} new comment_objects from new_ids through undo took ${t}ns (${o} per object)",
+      ilog( "Removing of ${x} new comment_objects through undo took ${t}ns (${o} per object)",
         ( "x", NUMBER_OF_OBJECTS )( "t", duration_ns )( "o", ( duration_ns + NUMBER_OF_OBJECTS - 1 ) / NUMBER_OF_OBJECTS ) );
       BOOST_REQUIRE_EQUAL( comment_idx.size(), comment_idx_size );
     }
 
-    // create small objects again (place on undo_state::new_ids)
+    // create small objects again (new objects, id at or above undo_state::old_next_id)
     {
       auto undo_session = db->start_undo_session();
       auto time_start = std::chrono::high_resolution_clock::now();
@@ -1834,12 +1983,12 @@ BOOST_AUTO_TEST_CASE( filled_undo_benchmark )
         ( "x", NUMBER_OF_OBJECTS )( "t", duration_ns )( "o", ( duration_ns + NUMBER_OF_OBJECTS - 1 ) / NUMBER_OF_OBJECTS ) );
       BOOST_REQUIRE_EQUAL( comment_idx.size(), comment_idx_size + NUMBER_OF_OBJECTS );
 
-      // remove small objects from undo session through commit (they are on new_ids, so their size does not matter)
+      // remove small objects from undo session through commit (they are new, so their size does not matter)
       time_start = std::chrono::high_resolution_clock::now();
       undo_session.push();
       db->commit( db->revision() );
       duration_ns = std::chrono::duration_cast< std::chrono::nanoseconds >( std::chrono::high_resolution_clock::now() - time_start ).count();
-      ilog( "Removing of ${x} new comment_objects from new_ids through commit took ${t}ns (${o} per object)",
+      ilog( "Removing of ${x} new comment_objects through commit took ${t}ns (${o} per object)",
         ( "x", NUMBER_OF_OBJECTS )( "t", duration_ns )( "o", ( duration_ns + NUMBER_OF_OBJECTS - 1 ) / NUMBER_OF_OBJECTS ) );
       BOOST_REQUIRE_EQUAL( comment_idx.size(), comment_idx_size + NUMBER_OF_OBJECTS );
     }